@@ -0,0 +1,90 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Snapshot comparison of a 1920x1080 frame against its reference: the old 
+// test.js check (read both PNGs, compare as strings) vs. decoding once and 
+// qt.compareImages() on the pixels, for a passing and a failing snapshot
+//
+
+var qt = require('..'),
+    fs = require('fs'),
+    os = require('os'),
+    path = require('path'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var W = 1920, H = 1080, N = 20;
+
+function frame(extra) {
+  var pixmap = new qt.QPixmap(W, H);
+  var painter = new qt.QPainter();
+  pixmap.fill(new qt.QColor(255, 255, 255));
+  painter.begin(pixmap);
+  for (var i = 0; i < 500; i++) {
+    painter.fillRect((i * 37) % W, (i * 91) % H, 120, 80, 
+        new qt.QColor(i % 256, (i * 3) % 256, (i * 7) % 256));
+  }
+  if (extra)
+    painter.fillRect(900, 500, 4, 4, new qt.QColor(0, 0, 0));
+  painter.end();
+  return pixmap;
+}
+
+var ref = frame(false), same = frame(false), changed = frame(true);
+var refFile = path.join(os.tmpdir(), 'bench-compare-ref.png'),
+    sameFile = path.join(os.tmpdir(), 'bench-compare-same.png');
+ref.save(refFile);
+same.save(sameFile);
+
+console.log('%dx%d x %d comparisons', W, H, N);
+
+var strings = bench.run('PNG toString()', N, function(n) {
+  for (var i = 0; i < n; i++)
+    fs.readFileSync(sameFile).toString() === fs.readFileSync(refFile).toString();
+});
+
+var refImage = ref.toImage(), sameImage = same.toImage(), 
+    changedImage = changed.toImage();
+
+var pixels = bench.run('compareImages (match)', N, function(n) {
+  for (var i = 0; i < n; i++)
+    qt.compareImages(sameImage, refImage);
+});
+
+bench.run('compareImages (diff + image)', N, function(n) {
+  for (var i = 0; i < n; i++)
+    qt.compareImages(changedImage, refImage, { diffImage: true });
+});
+
+bench.ratio('speedup', strings, pixels);
+
+fs.unlinkSync(refFile);
+fs.unlinkSync(sameFile);
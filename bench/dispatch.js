@@ -0,0 +1,111 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Per-call argument dispatch cost for methods that take wrapped objects.
+//
+// To measure what type tags save, build a checkout from before them next 
+// to this one and point QT_BASELINE at it; each build runs in its own 
+// process and the per-call difference is printed:
+//
+//   git worktree add ../node-qt-baseline <commit before type tags>
+//   (cd ../node-qt-baseline && npm install)
+//   QT_BASELINE=../node-qt-baseline node bench/dispatch.js
+//
+
+var child_process = require('child_process'),
+    path = require('path');
+
+var N = 200000;
+
+if (process.argv[2] === 'child') {
+  var qt = require(process.argv[3]),
+      bench = require('./bench');
+
+  var app = new qt.QApplication();
+  var pixmap = new qt.QPixmap(100, 100);
+  var painter = new qt.QPainter();
+  var color = new qt.QColor(0, 128, 255);
+  var brush = new qt.QBrush(qt.GlobalColor.blue);
+  var pen = new qt.QPen(color);
+  var results = {};
+
+  painter.begin(pixmap);
+
+  results['fillRect(QColor)'] = bench.run('fillRect(QColor)', N, 
+      function(n) {
+    for (var i = 0; i < n; i++)
+      painter.fillRect(0, 0, 1, 1, color);
+  });
+
+  results['fillRect(QBrush)'] = bench.run('fillRect(QBrush)', N, 
+      function(n) {
+    for (var i = 0; i < n; i++)
+      painter.fillRect(0, 0, 1, 1, brush);
+  });
+
+  results['setPen(QPen)'] = bench.run('setPen(QPen)', N, function(n) {
+    for (var i = 0; i < n; i++)
+      painter.setPen(pen);
+  });
+
+  painter.end();
+  console.log(JSON.stringify(results));
+  return;
+}
+
+function run(label, root) {
+  console.log(' %s (%s):', label, root);
+  var child = child_process.spawnSync(process.execPath, 
+      [__filename, 'child', path.resolve(root)], { encoding: 'utf8' });
+  if (child.status !== 0) {
+    console.log('  failed (%s)', 
+        (child.stderr || '').trim().split('\n').pop());
+    return null;
+  }
+
+  var lines = child.stdout.trim().split('\n');
+  console.log(lines.slice(0, -1).join('\n'));
+  return JSON.parse(lines.pop());
+}
+
+var current = run('this build', path.join(__dirname, '..'));
+var baseline = process.env.QT_BASELINE ? 
+    run('baseline', process.env.QT_BASELINE) : null;
+
+if (current && baseline) {
+  Object.keys(current).forEach(function(name) {
+    console.log('  %s: %s ns per call saved', name, 
+        ((baseline[name] - current[name]) / N * 1e6).toFixed(1));
+    require('./bench').ratio(name + ', this build vs. baseline', 
+        baseline[name], current[name]);
+  });
+} else if (!process.env.QT_BASELINE) {
+  console.log('  set QT_BASELINE to compare against another build');
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Idle CPU and update()-to-paintEvent latency with the setInterval() 
+// processEvents() polling loop vs. eventLoop 'libuv'. Each mode runs in 
+// its own process, since a process holds a single QApplication.
+//
+
+var child_process = require('child_process');
+
+var IDLE_MS = 1000;
+var ROUNDS = 200;
+
+if (process.argv[2] === 'child') {
+  var qt = require('..');
+  var mode = process.argv[3];
+  var app = new qt.QApplication(mode === 'libuv' ? 
+      { headless: true, eventLoop: 'libuv' } : { headless: true });
+
+  var poller = mode === 'poll' ? 
+      setInterval(function() { app.processEvents(); }, 0) : null;
+
+  var widget = new qt.QWidget();
+  widget.resize(100, 100);
+
+  var requested = null, latencies = [];
+  widget.paintEvent(function() {
+    if (requested === null)
+      return;
+    var t = process.hrtime(requested);
+    latencies.push(t[0] * 1e3 + t[1] / 1e6);
+    requested = null;
+    setTimeout(next, 1);
+  });
+
+  function next() {
+    if (latencies.length === ROUNDS)
+      return finish();
+    requested = process.hrtime();
+    widget.update();
+  }
+
+  function finish() {
+    // Nothing to do for a while: what does waiting cost?
+    var before = process.cpuUsage();
+    setTimeout(function() {
+      var cpu = process.cpuUsage(before);
+      latencies.sort(function(a, b) { return a - b; });
+
+      console.log(JSON.stringify({
+        cpu: (cpu.user + cpu.system) / 1e3 / IDLE_MS * 100,
+        mean: latencies.reduce(function(a, b) { return a + b; }) / ROUNDS,
+        p99: latencies[Math.floor(ROUNDS * 0.99)]
+      }));
+
+      if (poller)
+        clearInterval(poller);
+      widget.close();
+      process.exit(0);
+    }, IDLE_MS);
+  }
+
+  widget.show();
+  setTimeout(next, 50);
+  return;
+}
+
+function run(mode) {
+  var child = child_process.spawnSync(process.execPath, 
+      [__filename, 'child', mode], { encoding: 'utf8' });
+  if (child.status !== 0) {
+    console.log('  %s: failed (%s)', mode, 
+        (child.stderr || '').trim().split('\n').pop());
+    return null;
+  }
+
+  var result = JSON.parse(child.stdout.trim().split('\n').pop());
+  console.log('  %s: idle cpu %s%%, latency mean %s ms, p99 %s ms', mode,
+      result.cpu.toFixed(1), result.mean.toFixed(3), result.p99.toFixed(3));
+  return result;
+}
+
+var poll = run('poll');
+var libuv = run('libuv');
+
+if (poll && libuv)
+  require('./bench').ratio('latency, libuv vs. poll', poll.mean, libuv.mean);
@@ -0,0 +1,77 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Per-event cost of the mouse event delivery modes. Each run simulates n 
+// clicks, i.e. 2n press/release events through the widget's handlers.
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication({ headless: true });
+
+var N = 20000;
+var widget = new qt.QWidget();
+widget.resize(100, 100);
+widget.show();
+app.processEvents();
+
+var events = new qt.QTestEventList();
+for (var i = 0; i < N; i++)
+  events.addMouseClick(qt.MouseButton.LeftButton);
+
+var sum = 0;
+
+function run(name, mode, handler) {
+  widget.mousePressEvent(handler, { mode: mode });
+  widget.mouseReleaseEvent(handler, { mode: mode });
+
+  return bench.run(name, 2 * N, function() {
+    events.simulate(widget);
+  });
+}
+
+var wrapper = run('wrapper', 'wrapper', function(e) {
+  sum += e.x() + e.y() + e.button();
+});
+
+var object = run('object', 'object', function(e) {
+  sum += e.x + e.y + e.button;
+});
+
+var args = run('args', 'args', function(x, y, buttons, modifiers, time, 
+    button) {
+  sum += x + y + button;
+});
+
+bench.ratio('object vs. wrapper', wrapper, object);
+bench.ratio('args vs. wrapper', wrapper, args);
+
+widget.close();
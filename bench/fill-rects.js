@@ -0,0 +1,81 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Per-call fillRect() vs. fillRects() for a heatmap-like grid
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var COLS = 250, ROWS = 200, N = COLS * ROWS;
+var PALETTE = 16;
+var pixmap = new qt.QPixmap(COLS * 4, ROWS * 4);
+var painter = new qt.QPainter();
+
+var palette = [], argbPalette = [];
+for (var i = 0; i < PALETTE; i++) {
+  var v = Math.round(i * 255 / (PALETTE - 1));
+  palette.push(new qt.QColor(v, 0, 255 - v));
+  argbPalette.push((0xff000000 | (v << 16) | (255 - v)) >>> 0);
+}
+
+var rects = new Int32Array(N * 4);
+var colors = new Uint32Array(N);
+var cellColors = [];
+for (var i = 0; i < N; i++) {
+  var c = (i * 7919) % PALETTE;
+  rects[i * 4] = (i % COLS) * 4;
+  rects[i * 4 + 1] = Math.floor(i / COLS) * 4;
+  rects[i * 4 + 2] = 4;
+  rects[i * 4 + 3] = 4;
+  colors[i] = argbPalette[c];
+  cellColors.push(palette[c]);
+}
+
+painter.begin(pixmap);
+
+console.log('%d cells, %d colors', N, PALETTE);
+
+var perCall = bench.run('fillRect loop', N, function(n) {
+  for (var i = 0; i < n; i++) {
+    painter.fillRect(rects[i * 4], rects[i * 4 + 1], rects[i * 4 + 2],
+        rects[i * 4 + 3], cellColors[i]);
+  }
+});
+
+var batched = bench.run('fillRects', N, function(n) {
+  painter.fillRects(rects, colors);
+});
+
+bench.ratio('speedup', perCall, batched);
+
+painter.end();
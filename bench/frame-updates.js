@@ -0,0 +1,96 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Repaints and paint time for a stream of update() calls, like a drag 
+// feeding a canvas, with Qt's own update handling vs. frame aligned 
+// updates (qt.setFrameAlignedUpdates()). The loop polls processEvents() 
+// between bursts of input as fast as it can; aligned updates cap the 
+// repaints at the frame rate.
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication({ headless: true });
+
+var DURATION_MS = 1000;
+var UPDATES_PER_BURST = 4;
+
+var widget = new qt.QWidget();
+widget.resize(500, 500);
+widget.show();
+app.processEvents();
+
+var pixmap = new qt.QPixmap(500, 500);
+var painter = new qt.QPainter();
+var paints = 0, paint_ms = 0;
+
+widget.paintEvent(function() {
+  var start = bench.now();
+  painter.begin(pixmap);
+  for (var i = 0; i < 50; i++)
+    painter.fillRect(i * 10, 0, 10, 500, new qt.QColor(i * 5, 0, 0));
+  painter.end();
+  paint_ms += bench.now() - start;
+  paints++;
+});
+
+function run(name, aligned, done) {
+  qt.setFrameAlignedUpdates(aligned);
+  qt.resetFrameStats();
+  paints = paint_ms = 0;
+
+  var bursts = 0, start = bench.now();
+  (function burst() {
+    if (bench.now() - start > DURATION_MS) {
+      qt.setFrameAlignedUpdates(false);
+      app.processEvents();
+      console.log('  %s: %d bursts, %d paints, %s ms painting', name, 
+          bursts, paints, paint_ms.toFixed(2));
+      return done(paint_ms);
+    }
+
+    for (var i = 0; i < UPDATES_PER_BURST; i++)
+      widget.update(i * 100, i * 100, 50, 50);
+    app.processEvents();
+    bursts++;
+    setImmediate(burst);
+  })();
+}
+
+run('qt updates', false, function(baseline) {
+  run('frame aligned', true, function(aligned) {
+    var stats = qt.frameStats();
+    console.log('  frame aligned: %d frames, %d dropped, avg %s ms', 
+        stats.frames, stats.dropped, stats.averageFrameTime.toFixed(3));
+    bench.ratio('paint time, frame aligned vs. qt', baseline, aligned);
+    widget.close();
+  });
+});
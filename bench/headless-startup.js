@@ -0,0 +1,107 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Process startup cost of a headless QApplication vs. one on the default 
+// platform. Each sample is a fresh child process that creates the 
+// application, paints one frame into a QPixmap and reports the elapsed 
+// time and its resident set size. Without DISPLAY the default platform 
+// runs under xvfb-run (server startup included, as in a CI setup), and is 
+// skipped if that isn't installed either.
+//
+
+var child_process = require('child_process'),
+    path = require('path');
+
+var SAMPLES = 5;
+
+if (process.argv[2] === 'child') {
+  var start = Date.now();
+  var qt = require('..');
+  var app = new qt.QApplication(process.argv[3] === 'headless' ? 
+      { headless: true } : undefined);
+
+  var pixmap = new qt.QPixmap(640, 480);
+  var painter = new qt.QPainter();
+  painter.begin(pixmap);
+  painter.fillRect(0, 0, 640, 480, new qt.QColor(40, 80, 120));
+  painter.end();
+
+  console.log(JSON.stringify({ 
+    ms: Date.now() - start, 
+    rss: process.memoryUsage().rss 
+  }));
+  process.exit(0);
+}
+
+function hasCommand(name) {
+  return child_process.spawnSync('sh', ['-c', 'command -v ' + name])
+      .status === 0;
+}
+
+function sample(command, args) {
+  var start = Date.now();
+  var child = child_process.spawnSync(command, args, { encoding: 'utf8' });
+  if (child.status !== 0)
+    return null;
+
+  var result = JSON.parse(child.stdout.trim().split('\n').pop());
+  result.wall = Date.now() - start;
+  return result;
+}
+
+function run(name, command, args) {
+  var total = { ms: 0, wall: 0, rss: 0 };
+  for (var i = 0; i < SAMPLES; i++) {
+    var result = sample(command, args);
+    if (!result) {
+      console.log('  %s: failed to start', name);
+      return;
+    }
+    total.ms += result.ms;
+    total.wall += result.wall;
+    total.rss += result.rss;
+  }
+
+  console.log('  %s: startup %s ms, process %s ms, rss %s MB', name,
+      (total.ms / SAMPLES).toFixed(1), (total.wall / SAMPLES).toFixed(1), 
+      (total.rss / SAMPLES / 1048576).toFixed(1));
+}
+
+var script = path.join(__dirname, path.basename(__filename));
+
+run('headless', process.execPath, [script, 'child', 'headless']);
+
+if (process.env.DISPLAY)
+  run('default platform', process.execPath, [script, 'child', 'default']);
+else if (hasCommand('xvfb-run'))
+  run('default platform (xvfb-run)', 'xvfb-run', 
+      ['-a', process.execPath, script, 'child', 'default']);
+else
+  console.log('  default platform: skipped, no DISPLAY or xvfb-run');
@@ -0,0 +1,81 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Drawing a 256x256 sprite 500 times per frame from a non-premultiplied 
+// ARGB32 QImage (converted on every drawImage), the same image converted 
+// once with convertToFormat(), and a QPixmap made with QPixmap.fromImage()
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var SIZE = 256, DRAWS = 500, FRAMES = 10;
+var Format = qt.QImage.Format;
+
+var pixels = new Buffer(SIZE * SIZE * 4);
+for (var i = 0; i < SIZE * SIZE; i++)
+  pixels.writeUInt32LE(((i & 0xff) << 24 | i & 0xffffff) >>> 0, i * 4);
+var argb = new qt.QImage(pixels, SIZE, SIZE, SIZE * 4, Format.Format_ARGB32);
+var premultiplied = argb.convertToFormat(Format.Format_ARGB32_Premultiplied);
+var pixmap = qt.QPixmap.fromImage(argb);
+
+var target = new qt.QPixmap(1024, 768);
+var painter = new qt.QPainter();
+painter.begin(target);
+
+console.log('%d draws x %d frames', DRAWS, FRAMES);
+
+function frames(draw) {
+  return function(n) {
+    for (var f = 0; f < n; f++)
+      for (var i = 0; i < DRAWS; i++)
+        draw((i * 37) % 768, (i * 53) % 512);
+  };
+}
+
+var converting = bench.run('drawImage ARGB32', FRAMES, frames(function(x, y) {
+  painter.drawImage(x, y, argb);
+}));
+
+var converted = bench.run('drawImage ARGB32_Premultiplied', FRAMES, 
+    frames(function(x, y) {
+  painter.drawImage(x, y, premultiplied);
+}));
+
+var native = bench.run('drawPixmap', FRAMES, frames(function(x, y) {
+  painter.drawPixmap(x, y, pixmap);
+}));
+
+bench.ratio('premultiplied speedup', converting, converted);
+bench.ratio('pixmap speedup', converting, native);
+
+painter.end();
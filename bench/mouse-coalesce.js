@@ -0,0 +1,94 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// JS callbacks and time for a burst of mouse moves delivered one by one 
+// vs. coalesced. Each run simulates N moves and then runs the event loop 
+// once, like a drag between two frames.
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication({ headless: true });
+
+var N = 2000;
+var widget = new qt.QWidget();
+widget.resize(500, 500);
+widget.setMouseTracking(true);
+widget.show();
+app.processEvents();
+
+var events = new qt.QTestEventList();
+for (var i = 0; i < N; i++)
+  events.addMouseMove(i % 500, (i * 7) % 500);
+
+var pixmap = new qt.QPixmap(500, 500);
+var painter = new qt.QPainter();
+painter.begin(pixmap);
+
+var calls = 0, samples = 0;
+
+function run(name, handler, options) {
+  widget.mouseMoveEvent(handler, options);
+  calls = samples = 0;
+
+  var elapsed = bench.run(name, N, function() {
+    events.simulate(widget);
+    app.processEvents();
+  });
+
+  // bench.run() runs twice
+  console.log('  %s: %d callbacks for %d moves', name, calls / 2, 
+      samples / 2);
+  return elapsed;
+}
+
+var each = run('per event', function(e) {
+  calls++;
+  samples++;
+  painter.fillRect(e.x(), e.y(), 4, 4, qt.GlobalColor.black);
+  widget.update();
+});
+
+var coalesced = run('coalesced', function(x, y, points) {
+  calls++;
+  samples += points.length / 3;
+  for (var i = 0; i < points.length; i += 3)
+    painter.fillRect(points[i], points[i + 1], 4, 4, qt.GlobalColor.black);
+  widget.update();
+}, { coalesce: true });
+
+if (samples === 0)
+  console.log('  (this Qt does not deliver simulated mouse moves)');
+else
+  bench.ratio('coalesced vs. per event', each, coalesced);
+
+painter.end();
+widget.close();
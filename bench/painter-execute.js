@@ -0,0 +1,112 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Per-call QPainter methods vs. one painter.execute() command stream
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var N = 50000;
+var pixmap = new qt.QPixmap(1000, 1000);
+var sprite = new qt.QPixmap(8, 8);
+var painter = new qt.QPainter();
+var Op = qt.QPainter.Op;
+
+sprite.fill(new qt.QColor(255, 0, 0));
+painter.begin(pixmap);
+
+console.log('fillRect x %d', N);
+{
+  var color = new qt.QColor(0, 128, 255);
+  var perCall = bench.run('per-call', N, function(n) {
+    for (var i = 0; i < n; i++)
+      painter.fillRect(i % 990, (i * 7) % 990, 10, 10, color);
+  });
+
+  var commands = new Float64Array(N * 6);
+  for (var i = 0, j = 0; i < N; i++) {
+    commands[j++] = Op.FillRect;
+    commands[j++] = i % 990;
+    commands[j++] = (i * 7) % 990;
+    commands[j++] = 10;
+    commands[j++] = 10;
+    commands[j++] = 0xff0080ff;
+  }
+  var batched = bench.run('execute', N, function(n) {
+    painter.execute(commands);
+  });
+  bench.ratio('speedup', perCall, batched);
+}
+
+console.log('drawText x %d', N);
+{
+  var strings = ['alpha', 'beta', 'gamma', 'delta'];
+  var perCall = bench.run('per-call', N, function(n) {
+    for (var i = 0; i < n; i++)
+      painter.drawText(i % 990, (i * 7) % 990, strings[i & 3]);
+  });
+
+  var commands = new Float64Array(N * 4);
+  for (var i = 0, j = 0; i < N; i++) {
+    commands[j++] = Op.DrawText;
+    commands[j++] = i % 990;
+    commands[j++] = (i * 7) % 990;
+    commands[j++] = i & 3;
+  }
+  var batched = bench.run('execute', N, function(n) {
+    painter.execute(commands, strings);
+  });
+  bench.ratio('speedup', perCall, batched);
+}
+
+console.log('drawPixmap x %d', N);
+{
+  var perCall = bench.run('per-call', N, function(n) {
+    for (var i = 0; i < n; i++)
+      painter.drawPixmap(i % 990, (i * 7) % 990, sprite);
+  });
+
+  var commands = new Float64Array(N * 4);
+  for (var i = 0, j = 0; i < N; i++) {
+    commands[j++] = Op.DrawPixmap;
+    commands[j++] = i % 990;
+    commands[j++] = (i * 7) % 990;
+    commands[j++] = 0;
+  }
+  var batched = bench.run('execute', N, function(n) {
+    painter.execute(commands, null, [sprite]);
+  });
+  bench.ratio('speedup', perCall, batched);
+}
+
+painter.end();
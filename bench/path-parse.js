@@ -0,0 +1,78 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// A 20k-segment outline built three ways: QPointF wrappers and lineTo(), 
+// QPainterPath.fromArrays() and QPainterPath.fromSvg()
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var SEGMENTS = 20000, ROUNDS = 10;
+var Verb = qt.QPainterPath.Verb;
+
+var verbs = new Uint8Array(SEGMENTS + 1);
+var coords = new Float64Array((SEGMENTS + 1) * 2);
+var d = [];
+for (var i = 0; i <= SEGMENTS; i++) {
+  var x = i * 0.05, y = 250 + 200 * Math.sin(i / 300);
+  verbs[i] = i ? Verb.LineTo : Verb.MoveTo;
+  coords[i * 2] = x;
+  coords[i * 2 + 1] = y;
+  d.push((i ? 'L' : 'M') + x.toFixed(2) + ' ' + y.toFixed(2));
+}
+d = d.join('');
+
+console.log('%d segments x %d rounds, %d bytes of path data', 
+            SEGMENTS, ROUNDS, d.length);
+
+var wrappers = bench.run('lineTo(QPointF)', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++) {
+    var path = new qt.QPainterPath();
+    path.moveTo(new qt.QPointF(coords[0], coords[1]));
+    for (var i = 1; i <= SEGMENTS; i++)
+      path.lineTo(new qt.QPointF(coords[i * 2], coords[i * 2 + 1]));
+  }
+});
+
+var arrays = bench.run('fromArrays', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++)
+    qt.QPainterPath.fromArrays(verbs, coords);
+});
+
+var svg = bench.run('fromSvg', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++)
+    qt.QPainterPath.fromSvg(d);
+});
+
+bench.ratio('fromArrays speedup', wrappers, arrays);
+bench.ratio('fromSvg speedup', wrappers, svg);
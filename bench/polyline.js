@@ -0,0 +1,73 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// A 100k-point series: QPainterPath built from QPointF wrappers vs. 
+// drawPolyline() straight from a Float64Array
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var POINTS = 100000, FRAMES = 5;
+var pixmap = new qt.QPixmap(1000, 500);
+var painter = new qt.QPainter();
+var pen = new qt.QPen(new qt.QColor(0, 0, 0));
+
+var series = new Float64Array(POINTS * 2);
+for (var i = 0; i < POINTS; i++) {
+  series[i * 2] = i * 1000 / POINTS;
+  series[i * 2 + 1] = 250 + 200 * Math.sin(i / 500);
+}
+
+painter.begin(pixmap);
+painter.setPen(pen);
+
+console.log('%d-point series x %d frames', POINTS, FRAMES);
+
+var wrappers = bench.run('QPainterPath', FRAMES, function(n) {
+  for (var f = 0; f < n; f++) {
+    var path = new qt.QPainterPath();
+    path.moveTo(new qt.QPointF(series[0], series[1]));
+    for (var i = 1; i < POINTS; i++)
+      path.lineTo(new qt.QPointF(series[i * 2], series[i * 2 + 1]));
+    painter.strokePath(path, pen);
+  }
+});
+
+var typed = bench.run('drawPolyline', FRAMES, function(n) {
+  for (var f = 0; f < n; f++)
+    painter.drawPolyline(series);
+});
+
+bench.ratio('speedup', wrappers, typed);
+
+painter.end();
@@ -0,0 +1,114 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Main-thread blocking of pixmap.save() vs. pixmap.saveAsync() on a large 
+// frame. "blocked" is the time spent inside the call itself; "max lag" is 
+// the worst delay seen by a 1ms timer while the encodes are in flight.
+//
+
+var qt = require('..'),
+    fs = require('fs'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var N = 4;
+var pixmap = new qt.QPixmap(3840, 2160);
+var painter = new qt.QPainter();
+
+// Something less trivial than a flat fill to compress
+painter.begin(pixmap);
+for (var i = 0; i < 2000; i++) {
+  painter.fillRect((i * 37) % 3840, (i * 91) % 2160, 120, 80, 
+      new qt.QColor(i % 256, (i * 3) % 256, (i * 7) % 256));
+}
+painter.end();
+
+function lagMonitor() {
+  var max = 0, last = bench.now();
+  var timer = setInterval(function() {
+    var now = bench.now();
+    max = Math.max(max, now - last - 1);
+    last = now;
+  }, 1);
+
+  return function stop() {
+    clearInterval(timer);
+    return max;
+  };
+}
+
+function report(name, blocked, lag) {
+  console.log('  %s: blocked %s ms, max lag %s ms', name, blocked.toFixed(2),
+      lag.toFixed(2));
+}
+
+function runSync(done) {
+  var stop = lagMonitor();
+  var blocked = 0;
+  var i = 0;
+
+  (function next() {
+    if (i++ === N) {
+      report('save()', blocked, stop());
+      return done();
+    }
+    var start = bench.now();
+    pixmap.save('__bench.png');
+    blocked += bench.now() - start;
+    setImmediate(next);
+  })();
+}
+
+function runAsync(done) {
+  var stop = lagMonitor();
+  var blocked = 0;
+  var pending = [];
+
+  for (var i = 0; i < N; i++) {
+    var start = bench.now();
+    pending.push(pixmap.saveAsync('__bench' + i + '.png'));
+    blocked += bench.now() - start;
+  }
+
+  Promise.all(pending).then(function() {
+    report('saveAsync()', blocked, stop());
+    done();
+  });
+}
+
+console.log('PNG encode of a 3840x2160 frame x %d', N);
+runSync(function() {
+  runAsync(function() {
+    fs.unlinkSync('__bench.png');
+    for (var i = 0; i < N; i++)
+      fs.unlinkSync('__bench' + i + '.png');
+  });
+});
@@ -0,0 +1,81 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Thumbnailing a 2400x1600 photo-sized image to 240x160: drawing through a 
+// scaled QPainter on the main thread vs. image.scaled() in each mode, and 
+// a batch of scaledAsync() calls overlapping on the threadpool
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var W = 2400, H = 1600, TW = 240, TH = 160, N = 10;
+var Format = qt.QImage.Format;
+
+var pixels = new Buffer(W * H * 4);
+for (var i = 0; i < W * H; i++)
+  pixels.writeUInt32LE((0xff000000 | (i * 2654435761) & 0xffffff) >>> 0, 
+                       i * 4);
+var image = new qt.QImage(pixels, W, H, W * 4, Format.Format_RGB32);
+
+console.log('%dx%d -> %dx%d x %d', W, H, TW, TH, N);
+
+var painted = bench.run('QPainter + setMatrix', N, function(n) {
+  for (var i = 0; i < n; i++) {
+    var thumb = new qt.QImage(new Buffer(TW * TH * 4), TW, TH, TW * 4, 
+        Format.Format_RGB32);
+    var painter = new qt.QPainter();
+    painter.begin(thumb);
+    painter.setMatrix(new qt.QMatrix(TW / W, 0, 0, TH / H, 0, 0));
+    painter.drawImage(0, 0, image);
+    painter.end();
+  }
+});
+
+['fast', 'smooth', 'lanczos'].forEach(function(mode) {
+  var elapsed = bench.run('scaled ' + mode, N, function(n) {
+    for (var i = 0; i < n; i++)
+      image.scaled(TW, TH, { mode: mode });
+  });
+  bench.ratio('speedup', painted, elapsed);
+});
+
+var start = bench.now();
+var batch = [];
+for (var i = 0; i < N; i++)
+  batch.push(image.scaledAsync(TW, TH, { mode: 'lanczos' }));
+var queued = bench.now() - start;
+
+Promise.all(batch).then(function() {
+  console.log('  scaledAsync lanczos: %d in %s ms, %s ms on the main thread',
+      N, (bench.now() - start).toFixed(2), queued.toFixed(2));
+});
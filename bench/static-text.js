@@ -0,0 +1,68 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// drawText() vs. drawStaticText() for unchanged labels redrawn every frame
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var N = 50000;
+var LABELS = 200;
+var pixmap = new qt.QPixmap(1000, 1000);
+var painter = new qt.QPainter();
+var font = new qt.QFont('helvetica', 10);
+
+var strings = [], statics = [];
+for (var i = 0; i < LABELS; i++) {
+  strings.push('Sensor ' + i + ': 42.0 kPa');
+  statics.push(new qt.QStaticText(strings[i], font));
+}
+
+painter.begin(pixmap);
+painter.setFont(font);
+
+console.log('%d draws of %d distinct labels', N, LABELS);
+
+var plain = bench.run('drawText', N, function(n) {
+  for (var i = 0; i < n; i++)
+    painter.drawText(i % 900, (i * 7) % 990, strings[i % LABELS]);
+});
+
+var cached = bench.run('drawStaticText', N, function(n) {
+  for (var i = 0; i < n; i++)
+    painter.drawStaticText(i % 900, (i * 7) % 990, statics[i % LABELS]);
+});
+
+bench.ratio('speedup', plain, cached);
+
+painter.end();
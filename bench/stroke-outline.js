@@ -0,0 +1,74 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// A dashed, thick outline drawn every frame: strokePath() re-strokes the 
+// geometry each time, fillPath() fills an outline made once by 
+// QPainterPathStroker
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var FRAMES = 200;
+var image = new qt.QImage(new Buffer(800 * 600 * 4), 800, 600, 800 * 4, 
+    qt.QImage.Format.Format_ARGB32_Premultiplied);
+var painter = new qt.QPainter();
+
+var d = 'M50 300';
+for (var i = 0; i < 40; i++)
+  d += ' Q' + (i * 18 + 59) + ' ' + (i % 2 ? 100 : 500) + ' ' + 
+       (i * 18 + 68) + ' 300';
+var path = qt.QPainterPath.fromSvg(d);
+
+var pen = new qt.QPen(new qt.QBrush(qt.GlobalColor.black), 6, 
+                      qt.PenStyle.DashDotLine, qt.PenCapStyle.RoundCap, 
+                      qt.PenJoinStyle.RoundJoin);
+var outline = new qt.QPainterPathStroker(pen).createStroke(path);
+
+painter.begin(image);
+
+console.log('%d frames, %d elements stroked to %d', 
+            FRAMES, path.elementCount(), outline.elementCount());
+
+var stroked = bench.run('strokePath', FRAMES, function(n) {
+  for (var f = 0; f < n; f++)
+    painter.strokePath(path, pen);
+});
+
+var filled = bench.run('fillPath(outline)', FRAMES, function(n) {
+  for (var f = 0; f < n; f++)
+    painter.fillPath(outline, qt.GlobalColor.black);
+});
+
+bench.ratio('speedup', stroked, filled);
+
+painter.end();
@@ -0,0 +1,90 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Single-threaded painter.execute() vs. QPainter.renderTiled() on a 
+// poster-sized image, for fill- and text-heavy command streams
+//
+
+var qt = require('..'),
+    os = require('os'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var W = 8000, H = 6000, N = 20000;
+var Op = qt.QPainter.Op;
+
+function makeImage() {
+  return new qt.QImage(new Buffer(W * H * 4), W, H, W * 4, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+}
+
+var fills = new Float64Array(N * 6);
+for (var i = 0, j = 0; i < N; i++) {
+  fills[j++] = Op.FillRect;
+  fills[j++] = (i * 37) % W;
+  fills[j++] = (i * 91) % H;
+  fills[j++] = 200;
+  fills[j++] = 150;
+  fills[j++] = 0x80000000 + ((i * 2654435761) & 0xffffff);
+}
+
+var strings = ['Lorem ipsum dolor sit amet', 'consectetur adipiscing elit',
+    'sed do eiusmod tempor', 'incididunt ut labore'];
+var text = new Float64Array(N * 4);
+for (var i = 0, j = 0; i < N; i++) {
+  text[j++] = Op.DrawText;
+  text[j++] = (i * 37) % W;
+  text[j++] = (i * 91) % H;
+  text[j++] = i & 3;
+}
+
+function compare(name, commands, strings) {
+  console.log('%s x %d on %dx%d (%d cores)', name, N, W, H, 
+      os.cpus().length);
+
+  var single = bench.run('execute', 1, function() {
+    var image = makeImage();
+    var painter = new qt.QPainter();
+    painter.begin(image);
+    painter.execute(commands, strings);
+    painter.end();
+  });
+
+  var tiled = bench.run('renderTiled', 1, function() {
+    qt.QPainter.renderTiled(makeImage(), commands, strings, null, 
+        { tileSize: 512 });
+  });
+
+  bench.ratio('speedup', single, tiled);
+}
+
+compare('fillRect', fills);
+compare('drawText', text, strings);
@@ -0,0 +1,97 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Hit-testing geometry: 500k points and 100k rects mapped through a 
+// rotate/scale/translate transform with per-point JS math vs. 
+// QTransform.map() and mapRects() over Float64Arrays
+//
+
+var qt = require('..'),
+    bench = require('./bench');
+
+var app = new qt.QApplication();
+
+var POINTS = 500000, RECTS = 100000, ROUNDS = 10;
+var t = new qt.QTransform().translate(400, 300).rotate(30).scale(1.5, 1.5);
+var m11 = t.m11(), m12 = t.m12(), m21 = t.m21(), m22 = t.m22(), 
+    dx = t.dx(), dy = t.dy();
+
+var points = new Float64Array(POINTS * 2);
+for (var i = 0; i < points.length; i++)
+  points[i] = Math.random() * 1000;
+var rects = new Float64Array(RECTS * 4);
+for (var i = 0; i < rects.length; i++)
+  rects[i] = Math.random() * 1000;
+var out = new Float64Array(points.length);
+var rectsOut = new Float64Array(rects.length);
+
+console.log('%d points, %d rects x %d rounds', POINTS, RECTS, ROUNDS);
+
+var jsPoints = bench.run('map (JS)', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++) {
+    for (var i = 0; i < points.length; i += 2) {
+      var x = points[i], y = points[i + 1];
+      out[i] = m11 * x + m21 * y + dx;
+      out[i + 1] = m12 * x + m22 * y + dy;
+    }
+  }
+});
+
+var nativePoints = bench.run('map', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++)
+    t.map(points, out);
+});
+
+var jsRects = bench.run('mapRects (JS)', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++) {
+    for (var i = 0; i < rects.length; i += 4) {
+      var xs = [], ys = [];
+      for (var c = 0; c < 4; c++) {
+        var x = rects[i] + (c & 1 ? rects[i + 2] : 0);
+        var y = rects[i + 1] + (c & 2 ? rects[i + 3] : 0);
+        xs.push(m11 * x + m21 * y + dx);
+        ys.push(m12 * x + m22 * y + dy);
+      }
+      var x0 = Math.min.apply(null, xs), y0 = Math.min.apply(null, ys);
+      rectsOut[i] = x0;
+      rectsOut[i + 1] = y0;
+      rectsOut[i + 2] = Math.max.apply(null, xs) - x0;
+      rectsOut[i + 3] = Math.max.apply(null, ys) - y0;
+    }
+  }
+});
+
+var nativeRects = bench.run('mapRects', ROUNDS, function(n) {
+  for (var r = 0; r < n; r++)
+    t.mapRects(rects, rectsOut);
+});
+
+bench.ratio('map speedup', jsPoints, nativePoints);
+bench.ratio('mapRects speedup', jsRects, nativeRects);
@@ -0,0 +1,94 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Offscreen QImage rendering of FRAMES frames on the main thread vs. split 
+// across one worker_threads Worker per core, each with its own isolate.
+//
+
+var os = require('os'),
+    qt = require('..'),
+    bench = require('./bench');
+
+var worker_threads;
+try {
+  worker_threads = require('worker_threads');
+} catch (e) {
+  console.log('  skipped: no worker_threads in node ' + process.version);
+  return;
+}
+
+var FRAMES = 64;
+
+function renderFrames(count) {
+  var image = new qt.QImage(1024, 768, qt.QImage.Format.Format_ARGB32_Premultiplied);
+  var painter = new qt.QPainter();
+  for (var f = 0; f < count; f++) {
+    painter.begin(image);
+    for (var i = 0; i < 2000; i++) {
+      painter.fillRect((i * 37 + f) % 1024, (i * 91) % 768, 40, 30, 
+          new qt.QColor(i % 256, (i * 3) % 256, f % 256));
+    }
+    painter.end();
+  }
+}
+
+if (!worker_threads.isMainThread) {
+  renderFrames(worker_threads.workerData);
+  worker_threads.parentPort.postMessage('done');
+  return;
+}
+
+var app = new qt.QApplication();
+
+function runWorkers(count, done) {
+  var remaining = count;
+  for (var i = 0; i < count; i++) {
+    var frames = Math.floor(FRAMES / count) + (i < FRAMES % count ? 1 : 0);
+    new worker_threads.Worker(__filename, { workerData: frames })
+        .on('message', function() {
+          if (--remaining === 0)
+            done();
+        });
+  }
+}
+
+var start = bench.now();
+renderFrames(FRAMES);
+var main = bench.now() - start;
+console.log('  main thread: %d frames in %s ms', FRAMES, main.toFixed(2));
+
+var cores = os.cpus().length;
+start = bench.now();
+runWorkers(cores, function() {
+  var workers = bench.now() - start;
+  console.log('  %d workers: %d frames in %s ms (worker startup included)', 
+      cores, FRAMES, workers.toFixed(2));
+  bench.ratio('speedup', main, workers);
+});
@@ -1,12 +1,17 @@
 {
+  'variables': {
+    'qt5%': '<!(pkg-config --exists Qt5Widgets Qt5Multimedia && echo 1 || echo 0)'
+  },
   'targets': [
     {
       'target_name': 'qt',
       'sources': [
         'src/qt.cc', 
+        'src/qt_v8.cc',
 
         'src/QtCore/qsize.cc',
         'src/QtCore/qpointf.cc',
+        'src/QtCore/uveventdispatcher.cc',
 
         'src/QtGui/qmouseevent.cc',
         'src/QtGui/qkeyevent.cc',
@@ -16,9 +21,19 @@
         'src/QtGui/qbrush.cc',
         'src/QtGui/qpen.cc',
         'src/QtGui/qimage.cc',
+        'src/QtGui/qimageio.cc',
+        'src/QtGui/imagescale.cc',
+        'src/QtGui/imagecompare.cc',
         'src/QtGui/qpainterpath.cc',
+        'src/QtGui/svgpath.cc',
+        'src/QtGui/qpainterpathstroker.cc',
         'src/QtGui/qfont.cc',
         'src/QtGui/qmatrix.cc',
+        'src/QtGui/qtransform.cc',
+        'src/QtGui/paintcommands.cc',
+        'src/QtGui/qpicture.cc',
+        'src/QtGui/qstatictext.cc',
+        'src/QtGui/qpixmapcache.cc',
         
         'src/QtWidgets/qapplication.cc',
         'src/QtWidgets/qwidgetwrapbase.cc',
@@ -30,6 +45,7 @@
         'src/QtWidgets/qlineedit.cc',
         'src/QtWidgets/qboxlayout.cc',
         'src/QtWidgets/qplaintextedit.cc',
+        'src/QtWidgets/framescheduler.cc',
         
         'src/QtMultimedia/qsound.cc',
 
@@ -51,7 +67,21 @@
             '<!@(pkg-config --libs Qt5Core Qt5Gui Qt5Test Qt5Widgets Qt5Multimedia|sed \'s, -framework [A-z_]*,,g; s,-F,,g\')',
           ],
         }],
-        ['OS=="linux"', {
+        ['OS=="linux" and qt5==1', { # Qt 5, needed for headless mode
+          'cflags': [
+            '<!@(pkg-config --cflags Qt5Core Qt5Gui Qt5Test Qt5Widgets Qt5Multimedia)',
+            # QPA headers (qpa/qwindowsysteminterface.h) for the libuv dispatcher
+            '-I<!(echo $(pkg-config --variable=includedir Qt5Gui)/QtGui/$(pkg-config --modversion Qt5Gui)/QtGui)',
+            '-fPIC'
+          ],
+          'ldflags': [
+            '<!@(pkg-config --libs-only-L --libs-only-other Qt5Core Qt5Gui Qt5Test Qt5Widgets Qt5Multimedia)'
+          ],
+          'libraries': [
+            '<!@(pkg-config --libs-only-l Qt5Core Qt5Gui Qt5Test Qt5Widgets Qt5Multimedia)'
+          ]
+        }],
+        ['OS=="linux" and qt5==0', {
           'cflags': [
             '<!@(pkg-config --cflags QtCore QtGui QtTest)'
           ],
@@ -65,11 +65,13 @@ widget.mousePressEvent(function(e) {
   widget.update();
 });
 
-widget.mouseMoveEvent(function(e) {
-  console.log('moved:', e.x(), e.y());
-  painter.fillRect(e.x(), e.y(), 10, 10, 9);
+// Every move since the last call arrives at once, as [x, y, time, ...]
+widget.mouseMoveEvent(function(x, y, points) {
+  console.log('moved:', x, y, '(' + points.length / 3 + ' samples)');
+  for (var i = 0; i < points.length; i += 3)
+    painter.fillRect(points[i], points[i + 1], 10, 10, 9);
   widget.update();
-});
+}, { coalesce: true });
 
 // Prevent objects from being GC'd
 global.window = window;
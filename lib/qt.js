@@ -30,15 +30,26 @@
 //
 // Load bindings binary
 //
+var isMainThread = true;
+try {
+  isMainThread = require('worker_threads').isMainThread;
+} catch (e) {
+  // no worker_threads in this version of node
+}
+
+// Workers can't chdir, but the main thread has already loaded the Qt 
+// libraries by the time a worker requires the addon
 var oldDir = process.cwd();
 try {
   // ensure we're in the right location so we can dynamically load the bundled Qt libraries
-  process.chdir(__dirname + '/../deps/qt-4.8.0/' + process.platform + '/' + process.arch);
+  if (isMainThread)
+    process.chdir(__dirname + '/../deps/qt-4.8.0/' + process.platform + '/' + process.arch);
 } catch (e) {
   // if no local deps/ dir, assume shared lib linking. keep going
 }
 var qt = require(__dirname + '/../build/Release/qt.node');
-process.chdir(oldDir);
+if (isMainThread)
+  process.chdir(oldDir);
 
 //
 // Qt::MouseButton
@@ -505,6 +516,87 @@ qt.Key = {
 };
 Object.freeze(qt.Key);
 
+//
+// Qt::FillRule
+//
+qt.FillRule = {
+  OddEvenFill: 0,
+  WindingFill: 1
+};
+Object.freeze(qt.FillRule);
+
+//
+// Qt::PenStyle
+//
+qt.PenStyle = {
+  NoPen: 0,
+  SolidLine: 1,
+  DashLine: 2,
+  DotLine: 3,
+  DashDotLine: 4,
+  DashDotDotLine: 5,
+  CustomDashLine: 6
+};
+Object.freeze(qt.PenStyle);
+
+//
+// Qt::PenCapStyle
+//
+qt.PenCapStyle = {
+  FlatCap: 0x00,
+  SquareCap: 0x10,
+  RoundCap: 0x20
+};
+Object.freeze(qt.PenCapStyle);
+
+//
+// Qt::PenJoinStyle
+//
+qt.PenJoinStyle = {
+  MiterJoin: 0x00,
+  BevelJoin: 0x40,
+  RoundJoin: 0x80,
+  SvgMiterJoin: 0x100
+};
+Object.freeze(qt.PenJoinStyle);
+
+//
+// Qt::AspectRatioMode
+// For the aspectRatioMode option of QImage/QPixmap.scaled()
+//
+qt.AspectRatioMode = {
+  IgnoreAspectRatio: 0,
+  KeepAspectRatio: 1,
+  KeepAspectRatioByExpanding: 2
+};
+Object.freeze(qt.AspectRatioMode);
+
+//
+// Qt::Axis
+// For QTransform.rotate()
+//
+qt.Axis = {
+  XAxis: 0,
+  YAxis: 1,
+  ZAxis: 2
+};
+Object.freeze(qt.Axis);
+
+//
+// Qt::KeyboardModifier
+// For the modifiers of events delivered in 'object' or 'args' mode
+//
+qt.KeyboardModifier = {
+  NoModifier:          0x00000000,
+  ShiftModifier:       0x02000000,
+  ControlModifier:     0x04000000,
+  AltModifier:         0x08000000,
+  MetaModifier:        0x10000000,
+  KeypadModifier:      0x20000000,
+  GroupSwitchModifier: 0x40000000
+};
+Object.freeze(qt.KeyboardModifier);
+
 //
 // Qt::QBoxLayout::Direction
 //
@@ -516,4 +608,192 @@ qt.QBoxLayout.Direction = {
 };
 Object.freeze(qt.QBoxLayout.Direction);
 
+//
+// QPainterPath.fromArrays() verbs
+// Each verb takes its points, in order, from the coords array:
+//   MoveTo, LineTo   x, y
+//   QuadTo           cx, cy, x, y
+//   CubicTo          c1x, c1y, c2x, c2y, x, y
+//   Close            -
+//
+qt.QPainterPath.Verb = {
+  MoveTo: 0,
+  LineTo: 1,
+  QuadTo: 2,
+  CubicTo: 3,
+  Close: 4
+};
+Object.freeze(qt.QPainterPath.Verb);
+
+//
+// QTransform::TransformationType, as returned by QTransform.type()
+//
+qt.QTransform.TransformationType = {
+  TxNone: 0x00,
+  TxTranslate: 0x01,
+  TxScale: 0x02,
+  TxRotate: 0x04,
+  TxShear: 0x08,
+  TxProject: 0x10
+};
+Object.freeze(qt.QTransform.TransformationType);
+
+//
+// QPainter.execute() opcodes
+// Each opcode is followed by its arguments in the command stream:
+//   Save, Restore         -
+//   FillRect              x, y, w, h, color (0xAARRGGBB)
+//   DrawText              x, y, index into strings
+//   DrawPixmap            x, y, index into resources (QPixmap or QImage)
+//   SetPen                index into resources (QPen)
+//   SetMatrix             m11, m12, m21, m22, dx, dy
+//
+qt.QPainter.Op = {
+  Save: 1,
+  Restore: 2,
+  FillRect: 3,
+  DrawText: 4,
+  DrawPixmap: 5,
+  SetPen: 6,
+  SetMatrix: 7
+};
+Object.freeze(qt.QPainter.Op);
+
+//
+// QImage::Format
+// Values from RGBX8888 on are only available with Qt 5
+//
+qt.QImage.Format = {
+  Format_Invalid: 0,
+  Format_Mono: 1,
+  Format_MonoLSB: 2,
+  Format_Indexed8: 3,
+  Format_RGB32: 4,
+  Format_ARGB32: 5,
+  Format_ARGB32_Premultiplied: 6,
+  Format_RGB16: 7,
+  Format_ARGB8565_Premultiplied: 8,
+  Format_RGB666: 9,
+  Format_ARGB6666_Premultiplied: 10,
+  Format_RGB555: 11,
+  Format_ARGB8555_Premultiplied: 12,
+  Format_RGB888: 13,
+  Format_RGB444: 14,
+  Format_ARGB4444_Premultiplied: 15,
+  Format_RGBX8888: 16,
+  Format_RGBA8888: 17,
+  Format_RGBA8888_Premultiplied: 18,
+  Format_BGR30: 19,
+  Format_A2BGR30_Premultiplied: 20,
+  Format_RGB30: 21,
+  Format_A2RGB30_Premultiplied: 22,
+  Format_Alpha8: 23,
+  Format_Grayscale8: 24
+};
+Object.freeze(qt.QImage.Format);
+
+//
+// QImage.load(pathOrBuffer, options) -> Promise<QImage>
+// Decodes on the libuv threadpool (see QImage.setLoadConcurrency()). 
+// Options: format, width, height (decode at a reduced size) and signal (an
+// AbortSignal). The promise has a cancel() method; a cancelled load rejects
+// with err.code === 'ECANCELED'.
+//
+qt.QImage.load = function(source, options) {
+  options = options || {};
+
+  var id, cancelled = false, signal = options.signal;
+
+  function cancel() {
+    cancelled = true;
+    if (id !== undefined)
+      qt.QImage.cancelLoad(id);
+  }
+
+  var promise = new Promise(function(resolve, reject) {
+    id = qt.QImage.loadAsync(source, options, function(err, image) {
+      if (signal)
+        signal.removeEventListener('abort', cancel);
+
+      if (err) {
+        if (cancelled)
+          err.code = 'ECANCELED';
+        reject(err);
+      } else {
+        resolve(image);
+      }
+    });
+  });
+
+  if (signal) {
+    if (signal.aborted)
+      cancel();
+    else
+      signal.addEventListener('abort', cancel);
+  }
+
+  promise.cancel = cancel;
+  return promise;
+};
+
+//
+// QImage/QPixmap.saveAsync(pathOrNull, format, quality, options) -> Promise
+// Encodes on the libuv threadpool. Resolves to a Buffer of the encoded bytes
+// when path is null, else to undefined once the file is written. quality is
+// 0-100 (JPEG etc.); options.compression is the PNG level 0-9 and overrides
+// quality.
+//
+[qt.QImage, qt.QPixmap].forEach(function(cls) {
+  var saveAsync = cls.prototype.saveAsync;
+
+  cls.prototype.saveAsync = function(path, format, quality, options) {
+    var self = this;
+
+    if (options && options.compression !== undefined) {
+      // Inverse of Qt's PNG mapping, level = (100 - quality) * 9 / 91
+      var level = Math.max(0, Math.min(9, options.compression | 0));
+      quality = 100 - Math.floor((level * 91 + 8) / 9);
+    }
+
+    return new Promise(function(resolve, reject) {
+      saveAsync.call(self, path === undefined ? null : path, format || null,
+          typeof quality === 'number' ? quality : -1, function(err, buffer) {
+        if (err)
+          reject(err);
+        else
+          resolve(buffer);
+      });
+    });
+  };
+});
+
+//
+// QImage.scaledAsync(width, height, options) -> Promise<QImage>
+// QImage.transformedAsync(transform, options) -> Promise<QImage>
+// As scaled() and transformed(), resampled on the libuv threadpool. The 
+// image must not be painted on or written through bits() until the promise 
+// settles.
+//
+['scaledAsync', 'transformedAsync'].forEach(function(name) {
+  var native = qt.QImage.prototype[name];
+
+  qt.QImage.prototype[name] = function() {
+    var self = this, args = Array.prototype.slice.call(arguments);
+    var count = name === 'scaledAsync' ? 3 : 2;
+
+    while (args.length < count)
+      args.push(undefined);
+    args.length = count;
+
+    return new Promise(function(resolve, reject) {
+      native.apply(self, args.concat(function(err, image) {
+        if (err)
+          reject(err);
+        else
+          resolve(image);
+      }));
+    });
+  };
+});
+
 module.exports = qt;
@@ -23,6 +23,22 @@ target.test = function() {
   });
 }
 
+target.bench = function() {
+  cd(root);
+
+  echo('_________________________________________________________________');
+  echo('Running Node-Qt benchmarks');
+  echo();
+
+  cd('bench');
+  ls('*.js').forEach(function(f) {
+    if (f === 'bench.js')
+      return;
+    echo('Running benchmark '+f);
+    exec('node '+f);
+  });
+}
+
 target.ref = function() {
   cd(root);
 
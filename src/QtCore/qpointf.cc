@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qpointf.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QPointFWrap::prototype;
-Nan::Persistent<Function> QPointFWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPointFWrap::prototype;
+qt_v8::PerIsolate<Function> QPointFWrap::constructor;
 
 // Supported implementations:
 //   QPointF (qreal x, qreal y)
@@ -52,7 +53,7 @@ NAN_MODULE_INIT(QPointFWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QPointF").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
   
   // Prototype
   Nan::SetPrototypeMethod(tpl, "x", X);
@@ -68,12 +69,13 @@ NAN_MODULE_INIT(QPointFWrap::Initialize) {
 NAN_METHOD(QPointFWrap::New) {
   QPointFWrap* w = new QPointFWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QPointFWrap::NewInstance(QPointF q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QPointFWrap* w = ObjectWrap::Unwrap<QPointFWrap>(instance);
   w->SetWrapped(q);
   
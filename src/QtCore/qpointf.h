@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPointF>
 
 class QPointFWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPointF* GetWrapped() const { return q_; };
   void SetWrapped(QPointF q) { 
@@ -45,7 +46,7 @@ class QPointFWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QPointF q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QPointFWrap(const Nan::FunctionCallbackInfo<v8::Value>& args);
   ~QPointFWrap();
   static NAN_METHOD(New);
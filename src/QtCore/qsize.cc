@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qsize.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QSizeWrap::prototype;
-Nan::Persistent<Function> QSizeWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QSizeWrap::prototype;
+qt_v8::PerIsolate<Function> QSizeWrap::constructor;
 
 QSizeWrap::QSizeWrap() : q_(NULL) {
   // Standalone constructor not implemented
@@ -47,7 +48,7 @@ NAN_MODULE_INIT(QSizeWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QSize").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "width", Width);
@@ -62,12 +63,13 @@ NAN_MODULE_INIT(QSizeWrap::Initialize) {
 NAN_METHOD(QSizeWrap::New) {
   QSizeWrap* w = new QSizeWrap();
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QSizeWrap::NewInstance(QSize q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QSizeWrap* w = ObjectWrap::Unwrap<QSizeWrap>(instance);
   w->SetWrapped(q);
 
@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QSize>
 
 class QSizeWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QSize* GetWrapped() const { return q_; };
   void SetWrapped(QSize q) { 
@@ -45,7 +46,7 @@ class QSizeWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QSize q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QSizeWrap();
   ~QSizeWrap();
   static NAN_METHOD(New);
@@ -0,0 +1,321 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "uveventdispatcher.h"
+
+#ifdef QT_UV_EVENT_DISPATCHER
+
+#include <nan.h>
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QTimerEvent>
+#include <qpa/qwindowsysteminterface.h>
+
+// Exported by QtCore; Qt's own dispatchers use it for hasPendingEvents()
+extern uint qGlobalPostedEventsCount();
+
+struct UvEventDispatcher::Timer {
+  uv_timer_t handle;
+  UvEventDispatcher* dispatcher;
+  int id;
+  int interval;
+  Qt::TimerType type;
+  QObject* object;
+  uint64_t due;
+};
+
+struct UvEventDispatcher::Poll {
+  uv_poll_t handle;
+  UvEventDispatcher* dispatcher;
+  int fd;
+  // Indexed by QSocketNotifier::Type: Read, Write, Exception
+  QSocketNotifier* notifiers[3];
+};
+
+// Handles are freed once libuv is done with them
+template <typename T>
+static void Free(uv_handle_t* handle) {
+  delete static_cast<T*>(handle->data);
+}
+
+static void FreeHandle(uv_handle_t* handle) {
+  delete reinterpret_cast<uv_async_t*>(handle);
+}
+
+UvEventDispatcher::UvEventDispatcher(uv_loop_t* loop) 
+    : loop_(loop), wake_up_(new uv_async_t) {
+  uv_async_init(loop_, wake_up_, OnWakeUp);
+  wake_up_->data = this;
+  uv_unref(reinterpret_cast<uv_handle_t*>(wake_up_));
+}
+
+UvEventDispatcher::~UvEventDispatcher() {
+  for (QHash<int, Timer*>::iterator it = timers_.begin(); 
+      it != timers_.end(); ++it)
+    CloseTimer(it.value());
+  timers_.clear();
+
+  for (QHash<int, Poll*>::iterator it = polls_.begin(); 
+      it != polls_.end(); ++it) {
+    uv_poll_stop(&it.value()->handle);
+    uv_close(reinterpret_cast<uv_handle_t*>(&it.value()->handle), 
+        Free<Poll>);
+  }
+  polls_.clear();
+
+  uv_close(reinterpret_cast<uv_handle_t*>(wake_up_), FreeHandle);
+}
+
+void UvEventDispatcher::SetKeepAlive(bool keep_alive) {
+  if (keep_alive)
+    uv_ref(reinterpret_cast<uv_handle_t*>(wake_up_));
+  else
+    uv_unref(reinterpret_cast<uv_handle_t*>(wake_up_));
+}
+
+bool UvEventDispatcher::Dispatch(QEventLoop::ProcessEventsFlags flags, 
+    bool from_loop) {
+  Nan::HandleScope scope;
+
+  Q_EMIT awake();
+  uint posted = qGlobalPostedEventsCount();
+  QCoreApplication::sendPostedEvents();
+
+  // Straight from libuv no Qt code is on the stack, so deleteLater() 
+  // objects can go; app.processEvents() may run inside an event handler
+  if (from_loop)
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+
+  bool sent = QWindowSystemInterface::sendWindowSystemEvents(flags);
+
+  // Lets the platform flush its connection, like before a poll() sleep
+  Q_EMIT aboutToBlock();
+  return sent || posted > 0;
+}
+
+bool UvEventDispatcher::processEvents(QEventLoop::ProcessEventsFlags flags) {
+  return Dispatch(flags, false);
+}
+
+bool UvEventDispatcher::hasPendingEvents() {
+  return qGlobalPostedEventsCount() > 0;
+}
+
+//
+// Timers
+//
+void UvEventDispatcher::registerTimer(int timer_id, int interval, 
+    Qt::TimerType timer_type, QObject* object) {
+  Timer* timer = new Timer;
+  timer->dispatcher = this;
+  timer->id = timer_id;
+  timer->interval = interval;
+  timer->type = timer_type;
+  timer->object = object;
+
+  // libuv doesn't repeat 0 ms timers; Qt's are "whenever idle" anyway
+  uint64_t period = qMax(interval, 1);
+  timer->due = uv_now(loop_) + period;
+
+  uv_timer_init(loop_, &timer->handle);
+  timer->handle.data = timer;
+  uv_timer_start(&timer->handle, OnTimer, period, period);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer->handle));
+
+  timers_.insert(timer_id, timer);
+}
+
+void UvEventDispatcher::CloseTimer(Timer* timer) {
+  uv_timer_stop(&timer->handle);
+  uv_close(reinterpret_cast<uv_handle_t*>(&timer->handle), Free<Timer>);
+}
+
+bool UvEventDispatcher::unregisterTimer(int timer_id) {
+  Timer* timer = timers_.take(timer_id);
+  if (!timer)
+    return false;
+
+  CloseTimer(timer);
+  return true;
+}
+
+bool UvEventDispatcher::unregisterTimers(QObject* object) {
+  bool found = false;
+
+  QHash<int, Timer*>::iterator it = timers_.begin();
+  while (it != timers_.end()) {
+    if (it.value()->object == object) {
+      CloseTimer(it.value());
+      it = timers_.erase(it);
+      found = true;
+    } else {
+      ++it;
+    }
+  }
+
+  return found;
+}
+
+QList<QAbstractEventDispatcher::TimerInfo> 
+    UvEventDispatcher::registeredTimers(QObject* object) const {
+  QList<TimerInfo> list;
+
+  for (QHash<int, Timer*>::const_iterator it = timers_.begin(); 
+      it != timers_.end(); ++it) {
+    const Timer* timer = it.value();
+    if (timer->object == object)
+      list << TimerInfo(timer->id, timer->interval, timer->type);
+  }
+
+  return list;
+}
+
+int UvEventDispatcher::remainingTime(int timer_id) {
+  Timer* timer = timers_.value(timer_id);
+  if (!timer)
+    return -1;
+
+  uint64_t now = uv_now(loop_);
+  return timer->due > now ? static_cast<int>(timer->due - now) : 0;
+}
+
+void UvEventDispatcher::OnTimer(uv_timer_t* handle) {
+  Timer* timer = static_cast<Timer*>(handle->data);
+  UvEventDispatcher* dispatcher = timer->dispatcher;
+
+  timer->due = uv_now(dispatcher->loop_) + qMax(timer->interval, 1);
+
+  // The handler may kill the timer; the struct lives until libuv closes it
+  {
+    Nan::HandleScope scope;
+    QTimerEvent event(timer->id);
+    QCoreApplication::sendEvent(timer->object, &event);
+  }
+
+  dispatcher->Dispatch(QEventLoop::AllEvents, true);
+}
+
+//
+// Socket notifiers
+//
+void UvEventDispatcher::registerSocketNotifier(QSocketNotifier* notifier) {
+  int fd = static_cast<int>(notifier->socket());
+  Poll* poll = polls_.value(fd);
+
+  if (!poll) {
+    poll = new Poll;
+    poll->dispatcher = this;
+    poll->fd = fd;
+    poll->notifiers[0] = poll->notifiers[1] = poll->notifiers[2] = NULL;
+
+    uv_poll_init(loop_, &poll->handle, fd);
+    poll->handle.data = poll;
+    uv_unref(reinterpret_cast<uv_handle_t*>(&poll->handle));
+    polls_.insert(fd, poll);
+  }
+
+  poll->notifiers[notifier->type()] = notifier;
+  UpdatePoll(poll);
+}
+
+void UvEventDispatcher::unregisterSocketNotifier(QSocketNotifier* notifier) {
+  Poll* poll = polls_.value(static_cast<int>(notifier->socket()));
+  if (!poll || poll->notifiers[notifier->type()] != notifier)
+    return;
+
+  poll->notifiers[notifier->type()] = NULL;
+  UpdatePoll(poll);
+}
+
+void UvEventDispatcher::UpdatePoll(Poll* poll) {
+  int events = 
+      (poll->notifiers[QSocketNotifier::Read] ? UV_READABLE : 0) |
+      (poll->notifiers[QSocketNotifier::Write] ? UV_WRITABLE : 0) |
+      (poll->notifiers[QSocketNotifier::Exception] ? UV_PRIORITIZED : 0);
+
+  if (events) {
+    uv_poll_start(&poll->handle, events, OnPoll);
+    return;
+  }
+
+  polls_.remove(poll->fd);
+  uv_poll_stop(&poll->handle);
+  uv_close(reinterpret_cast<uv_handle_t*>(&poll->handle), Free<Poll>);
+}
+
+void UvEventDispatcher::OnPoll(uv_poll_t* handle, int status, int events) {
+  Poll* poll = static_cast<Poll*>(handle->data);
+  UvEventDispatcher* dispatcher = poll->dispatcher;
+
+  // On errors let every notifier find out from its own read/write
+  if (status < 0)
+    events = UV_READABLE | UV_WRITABLE | UV_PRIORITIZED;
+
+  static const int kEvents[3] = { UV_READABLE, UV_WRITABLE, UV_PRIORITIZED };
+
+  {
+    Nan::HandleScope scope;
+
+    for (int type = 0; type < 3; type++) {
+      // An earlier notifier may have unregistered this one
+      if (!(events & kEvents[type]) || 
+          dispatcher->polls_.value(poll->fd) != poll || 
+          !poll->notifiers[type])
+        continue;
+
+      QEvent event(QEvent::SockAct);
+      QCoreApplication::sendEvent(poll->notifiers[type], &event);
+    }
+  }
+
+  dispatcher->Dispatch(QEventLoop::AllEvents, true);
+}
+
+//
+// Wake-ups
+//
+void UvEventDispatcher::wakeUp() {
+  // Thread safe; several calls before the loop runs make one callback
+  uv_async_send(wake_up_);
+}
+
+void UvEventDispatcher::OnWakeUp(uv_async_t* handle) {
+  static_cast<UvEventDispatcher*>(handle->data)->Dispatch(
+      QEventLoop::AllEvents, true);
+}
+
+void UvEventDispatcher::interrupt() {
+  // processEvents() never blocks, so there is no wait to cut short
+  wakeUp();
+}
+
+void UvEventDispatcher::flush() {
+}
+
+#endif
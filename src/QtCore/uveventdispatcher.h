@@ -0,0 +1,109 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <QtGlobal>
+
+// The libuv dispatcher needs Qt 5's QPA, and a platform whose events 
+// arrive through file descriptors and wake-ups (xcb, offscreen, minimal). 
+// Cocoa and Windows deliver native events through their own dispatchers.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0) && defined(Q_OS_UNIX) && \
+    !defined(Q_OS_MAC)
+#define QT_UV_EVENT_DISPATCHER 1
+#endif
+
+#ifdef QT_UV_EVENT_DISPATCHER
+
+#include <uv.h>
+#include <QAbstractEventDispatcher>
+#include <QHash>
+
+//
+// UvEventDispatcher
+// Runs Qt's main thread events inside node's libuv loop, selected with 
+// new QApplication({ eventLoop: 'libuv' }). QTimers are uv timers, socket
+// notifiers (e.g. the X11 connection) are uv polls, and wakeUp() (posted 
+// events, the xcb reader thread) is a uv async. Each of them dispatches 
+// the ready Qt events right away, so nothing is polled and an idle GUI 
+// costs no CPU.
+//
+// processEvents() never blocks: blocking would stall node's loop, which 
+// is the one that waits. Nested Qt loops (QEventLoop::exec(), modal 
+// dialogs) therefore spin instead of sleeping.
+//
+// All handles are unreferenced, so they don't keep node alive by 
+// themselves; SetKeepAlive() does, from app.exec() until quit() or the 
+// last window closes.
+//
+class UvEventDispatcher : public QAbstractEventDispatcher {
+ public:
+  explicit UvEventDispatcher(uv_loop_t* loop);
+  ~UvEventDispatcher();
+
+  void SetKeepAlive(bool keep_alive);
+
+  bool processEvents(QEventLoop::ProcessEventsFlags flags);
+  bool hasPendingEvents();
+
+  void registerSocketNotifier(QSocketNotifier* notifier);
+  void unregisterSocketNotifier(QSocketNotifier* notifier);
+
+  void registerTimer(int timer_id, int interval, Qt::TimerType timer_type,
+      QObject* object);
+  bool unregisterTimer(int timer_id);
+  bool unregisterTimers(QObject* object);
+  QList<TimerInfo> registeredTimers(QObject* object) const;
+  int remainingTime(int timer_id);
+
+  void wakeUp();
+  void interrupt();
+  void flush();
+
+ private:
+  struct Timer;
+  struct Poll;
+
+  static void OnTimer(uv_timer_t* handle);
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+  static void OnWakeUp(uv_async_t* handle);
+
+  // Sends posted and window system events; from_loop when called by a 
+  // libuv callback rather than processEvents()
+  bool Dispatch(QEventLoop::ProcessEventsFlags flags, bool from_loop);
+  void UpdatePoll(Poll* poll);
+  void CloseTimer(Timer* timer);
+
+  uv_loop_t* loop_;
+  uv_async_t* wake_up_;
+  QHash<int, Timer*> timers_;
+  QHash<int, Poll*> polls_;
+};
+
+#endif
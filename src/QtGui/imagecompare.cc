@@ -0,0 +1,271 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string.h>
+#include <QPixmap>
+#include <QVector>
+#include "imagecompare.h"
+#include "qimage.h"
+#include "qpixmap.h"
+#include "../qt_v8.h"
+#include "../qt_parallel.h"
+
+using namespace v8;
+
+// Rows per band handed to a pool thread
+static const int kBandRows = 64;
+
+// Compared as premultiplied ARGB, which RGB32 already is
+static QImage Premultiplied(const QImage& image) {
+  if (image.format() == QImage::Format_RGB32 || 
+      image.format() == QImage::Format_ARGB32_Premultiplied)
+    return image;
+
+  return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+//
+// CompareJob
+// Each band fills its own Result; Done() merges them on the calling thread
+//
+class CompareJob : public qt_parallel::Job {
+ public:
+  CompareJob(const QImage& a, const QImage& b, int tolerance, QImage* diff)
+      : a_(a.constBits()), b_(b.constBits()), 
+        a_bpl_(a.bytesPerLine()), b_bpl_(b.bytesPerLine()), 
+        width_(a.width()), height_(a.height()), tolerance_(tolerance), 
+        diff_(diff ? diff->bits() : NULL), 
+        diff_bpl_(diff ? diff->bytesPerLine() : 0),
+        bands_((height_ + kBandRows - 1) / kBandRows) {}
+
+  int bands() const { return bands_.size(); }
+  const ImageCompare::Result& result() const { return result_; }
+
+  void Run(int index) {
+    ImageCompare::Result& band = bands_[index];
+    int first = index * kBandRows, last = qMin(height_, first + kBandRows);
+    const size_t row_bytes = size_t(width_) * 4;
+
+    for (int y = first; y < last; y++) {
+      const QRgb* a = reinterpret_cast<const QRgb*>(a_ + y * a_bpl_);
+      const QRgb* b = reinterpret_cast<const QRgb*>(b_ + y * b_bpl_);
+      QRgb* diff = diff_ ? 
+          reinterpret_cast<QRgb*>(diff_ + y * diff_bpl_) : NULL;
+
+      // Most rows of a passing snapshot are identical
+      if (memcmp(a, b, row_bytes) == 0) {
+        if (diff)
+          Fade(a, diff);
+        continue;
+      }
+
+      int row_first = -1, row_last = -1, row_delta = 0, row_count = 0;
+
+      for (int x = 0; x < width_; x++) {
+        int delta = Delta(a[x], b[x]);
+        row_delta = qMax(row_delta, delta);
+
+        bool differs = delta > tolerance_;
+        if (differs) {
+          if (row_first < 0)
+            row_first = x;
+          row_last = x;
+          row_count++;
+        }
+
+        if (diff)
+          diff[x] = differs ? 0xffff0000 : Faded(a[x]);
+      }
+
+      band.max_delta = qMax(band.max_delta, row_delta);
+      if (row_count) {
+        band.diff_pixels += row_count;
+        band.bounds |= QRect(row_first, y, row_last - row_first + 1, 1);
+      }
+    }
+  }
+
+  void Done(int index) {
+    const ImageCompare::Result& band = bands_[index];
+    result_.diff_pixels += band.diff_pixels;
+    result_.max_delta = qMax(result_.max_delta, band.max_delta);
+    result_.bounds |= band.bounds;
+  }
+
+ private:
+  // Largest of the four channel deltas
+  static inline int Delta(QRgb a, QRgb b) {
+    int delta = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      int d = int((a >> shift) & 0xff) - int((b >> shift) & 0xff);
+      delta = qMax(delta, d < 0 ? -d : d);
+    }
+    return delta;
+  }
+
+  // Light gray from the pixel's luma, so differences stand out
+  static inline QRgb Faded(QRgb p) {
+    int gray = 192 + qGray(p) / 4;
+    return qRgb(gray, gray, gray);
+  }
+
+  void Fade(const QRgb* in, QRgb* out) const {
+    for (int x = 0; x < width_; x++)
+      out[x] = Faded(in[x]);
+  }
+
+  const uchar* a_;
+  const uchar* b_;
+  int a_bpl_, b_bpl_;
+  int width_, height_;
+  int tolerance_;
+  uchar* diff_;
+  int diff_bpl_;
+  QVector<ImageCompare::Result> bands_;
+  ImageCompare::Result result_;
+};
+
+ImageCompare::Result ImageCompare::Compare(const QImage& a, 
+    const QImage& b, int tolerance, QImage* diff) {
+  QImage pa = Premultiplied(a), pb = Premultiplied(b);
+
+  if (diff)
+    *diff = QImage(a.size(), QImage::Format_RGB32);
+
+  // Bits are taken here; the pool threads only read and write memory
+  CompareJob job(pa, pb, tolerance, diff);
+
+  if (job.bands() == 1) {
+    job.Run(0);
+    job.Done(0);
+  } else if (job.bands() > 1) {
+    qt_parallel::Run(&job, job.bands());
+  }
+
+  return job.result();
+}
+
+NAN_MODULE_INIT(ImageCompare::Initialize) {
+  Nan::SetMethod(target, "compareImages", CompareImages);
+}
+
+// Returns a QImage for a QImage or QPixmap argument, or a null image
+static QImage ToImage(Local<Value> value) {
+  if (qt_v8::HasTag(value, &QImageWrap::prototype))
+    return *node::ObjectWrap::Unwrap<QImageWrap>(
+        value->ToObject())->GetWrapped();
+
+  if (qt_v8::HasTag(value, &QPixmapWrap::prototype))
+    return node::ObjectWrap::Unwrap<QPixmapWrap>(
+        value->ToObject())->GetWrapped()->toImage();
+
+  return QImage();
+}
+
+static Local<Value> Option(Local<Value> options, const char* name) {
+  if (!options->IsObject())
+    return Nan::Undefined();
+
+  return Nan::Get(options->ToObject(), Nan::New(name).ToLocalChecked())
+      .ToLocalChecked();
+}
+
+// Supported versions:
+//   qt.compareImages( QImage|QPixmap a, QImage|QPixmap b, Object options )
+// Options:
+//   tolerance       largest channel delta (0-255) still counted as equal, 0
+//   maxDiffPixels   differing pixels allowed for a match, 0
+//   diffImage       true to get a QImage of a with differences in red
+// Returns { match, width, height, diffPixels, maxDelta, bounds, diffImage }.
+// bounds is { x, y, width, height } or null. Images of different sizes 
+// don't match and have sizeMismatch: true.
+NAN_METHOD(ImageCompare::CompareImages) {
+  bool a_ok = qt_v8::HasTag(info[0], &QImageWrap::prototype) || 
+      qt_v8::HasTag(info[0], &QPixmapWrap::prototype);
+  bool b_ok = qt_v8::HasTag(info[1], &QImageWrap::prototype) || 
+      qt_v8::HasTag(info[1], &QPixmapWrap::prototype);
+
+  if (!a_ok || !b_ok || !(info[2]->IsObject() || info[2]->IsUndefined()))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("compareImages: bad arguments").ToLocalChecked()));
+
+  Local<Value> tolerance_value = Option(info[2], "tolerance");
+  Local<Value> max_value = Option(info[2], "maxDiffPixels");
+  int tolerance = tolerance_value->IsNumber() ? 
+      qBound(0, static_cast<int>(tolerance_value->Int32Value()), 255) : 0;
+  double max_diff_pixels = max_value->IsNumber() ? 
+      max_value->NumberValue() : 0;
+  bool want_diff = Option(info[2], "diffImage")->BooleanValue();
+
+  QImage a = ToImage(info[0]), b = ToImage(info[1]);
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("width").ToLocalChecked(), Nan::New(a.width()));
+  Nan::Set(result, Nan::New("height").ToLocalChecked(), 
+      Nan::New(a.height()));
+
+  if (a.size() != b.size()) {
+    Nan::Set(result, Nan::New("match").ToLocalChecked(), Nan::False());
+    Nan::Set(result, Nan::New("sizeMismatch").ToLocalChecked(), 
+        Nan::True());
+    info.GetReturnValue().Set(result);
+    return;
+  }
+
+  QImage diff;
+  Result r = Compare(a, b, tolerance, want_diff ? &diff : NULL);
+
+  Nan::Set(result, Nan::New("match").ToLocalChecked(), 
+      Nan::New(r.diff_pixels <= max_diff_pixels));
+  Nan::Set(result, Nan::New("diffPixels").ToLocalChecked(), 
+      Nan::New(static_cast<double>(r.diff_pixels)));
+  Nan::Set(result, Nan::New("maxDelta").ToLocalChecked(), 
+      Nan::New(r.max_delta));
+
+  if (r.bounds.isValid()) {
+    Local<Object> bounds = Nan::New<Object>();
+    Nan::Set(bounds, Nan::New("x").ToLocalChecked(), 
+        Nan::New(r.bounds.x()));
+    Nan::Set(bounds, Nan::New("y").ToLocalChecked(), 
+        Nan::New(r.bounds.y()));
+    Nan::Set(bounds, Nan::New("width").ToLocalChecked(), 
+        Nan::New(r.bounds.width()));
+    Nan::Set(bounds, Nan::New("height").ToLocalChecked(), 
+        Nan::New(r.bounds.height()));
+    Nan::Set(result, Nan::New("bounds").ToLocalChecked(), bounds);
+  } else {
+    Nan::Set(result, Nan::New("bounds").ToLocalChecked(), Nan::Null());
+  }
+
+  if (want_diff)
+    Nan::Set(result, Nan::New("diffImage").ToLocalChecked(), 
+        QImageWrap::NewInstance(diff));
+
+  info.GetReturnValue().Set(result);
+}
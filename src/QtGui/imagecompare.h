@@ -0,0 +1,63 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <QImage>
+#include <QRect>
+
+//
+// ImageCompare
+// qt.compareImages(a, b, options): pixel diffs of two QImages/QPixmaps 
+// for regression tests. Both are compared as premultiplied ARGB, so 
+// differences hidden by zero alpha don't count. Rows are compared in 
+// bands on the global QThreadPool.
+//
+class ImageCompare {
+ public:
+  static NAN_MODULE_INIT(Initialize);
+
+  struct Result {
+    Result() : diff_pixels(0), max_delta(0) {}
+
+    qint64 diff_pixels;   // pixels with a channel delta above tolerance
+    int max_delta;        // largest channel delta over all pixels
+    QRect bounds;         // of the differing pixels
+  };
+
+  // a and b must be the same size. If diff isn't null it's filled with a
+  // faded copy of a, differing pixels in red.
+  static Result Compare(const QImage& a, const QImage& b, int tolerance, 
+      QImage* diff);
+
+ private:
+  static NAN_METHOD(CompareImages);
+};
@@ -0,0 +1,635 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include <qmath.h>
+#include "imagescale.h"
+#include "qimage.h"
+#include "qmatrix.h"
+#include "qtransform.h"
+#include "../qt_v8.h"
+#include "../qt_parallel.h"
+
+using namespace v8;
+
+namespace imagescale {
+
+// Rows per band handed to a pool thread
+static const int kBandRows = 16;
+
+//
+// RowJob
+// Calls Rows() over bands of kBandRows rows, on the pool when there's more
+// than one band
+//
+class RowJob : public qt_parallel::Job {
+ public:
+  void Start(int rows) {
+    rows_ = rows;
+    int bands = (rows + kBandRows - 1) / kBandRows;
+
+    if (bands == 1)
+      Run(0);
+    else if (bands > 1)
+      qt_parallel::Run(this, bands);
+  }
+
+  void Run(int index) {
+    int first = index * kBandRows;
+    Rows(first, qMin(rows_, first + kBandRows));
+  }
+
+ protected:
+  virtual void Rows(int first, int last) = 0;
+
+ private:
+  int rows_;
+};
+
+//
+// Plane
+// Pixel rows of a 32-bit image. Taken on the calling thread, since 
+// QImage::scanLine() may detach and isn't safe to call from pool threads.
+//
+struct Plane {
+  explicit Plane(const QImage& image) 
+      : bits(const_cast<uchar*>(image.constBits())), 
+        bpl(image.bytesPerLine()), width(image.width()), 
+        height(image.height()) {}
+
+  QRgb* Row(int y) const { return reinterpret_cast<QRgb*>(bits + y * bpl); }
+
+  uchar* bits;
+  int bpl, width, height;
+};
+
+// Detaches a target image before its rows are handed to the pool
+static const QImage& Detached(QImage* image) {
+  image->bits();
+  return *image;
+}
+
+static bool Is32Bit(const QImage& image) {
+  return image.format() == QImage::Format_RGB32 || 
+      image.format() == QImage::Format_ARGB32 || 
+      image.format() == QImage::Format_ARGB32_Premultiplied;
+}
+
+// Filters read sources as premultiplied ARGB; RGB32 already is 
+// (0xffRRGGBB). Nearest neighbour copies pixels, so it reads any 32-bit 
+// format as is: a round trip through premultiplied would change the 
+// colour of semi-transparent ARGB32 pixels.
+static QImage Working(const QImage& image, Mode mode) {
+  if (image.format() == QImage::Format_RGB32 || 
+      image.format() == QImage::Format_ARGB32_Premultiplied || 
+      (mode == Fast && Is32Bit(image)))
+    return image;
+
+  return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+static QImage::Format ResultFormat(const QImage& image) {
+  switch (image.format()) {
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+      return image.format();
+    default:
+      return image.hasAlphaChannel() ? 
+          QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+  }
+}
+
+//
+// Nearest neighbour
+//
+
+class NearestJob : public RowJob {
+ public:
+  NearestJob(const QImage& source, QImage* target) 
+      : in_(source), out_(Detached(target)) {
+    xs_ = Centers(in_.width, out_.width);
+    ys_ = Centers(in_.height, out_.height);
+  }
+
+ protected:
+  void Rows(int first, int last) {
+    const int* xs = xs_.constData();
+
+    for (int y = first; y < last; y++) {
+      const QRgb* in = in_.Row(ys_[y]);
+      QRgb* out = out_.Row(y);
+
+      for (int x = 0; x < out_.width; x++)
+        out[x] = in[xs[x]];
+    }
+  }
+
+ private:
+  // Source sample under the center of each of to samples
+  static QVector<int> Centers(int from, int to) {
+    QVector<int> centers(to);
+    for (int i = 0; i < to; i++)
+      centers[i] = qMin(from - 1, int((i + 0.5) * from / to));
+    return centers;
+  }
+
+  Plane in_, out_;
+  QVector<int> xs_, ys_;
+};
+
+//
+// Separable filters: a horizontal pass from the source into a float 
+// buffer, then a vertical pass into the target. Inner loops run over 
+// plain float arrays so the compiler can vectorize them.
+//
+
+static double Kernel(double x, Mode mode) {
+  x = qAbs(x);
+
+  if (mode == Lanczos) {
+    if (x < 1e-8)
+      return 1;
+    if (x >= 3)
+      return 0;
+
+    // sinc(x) * sinc(x / 3)
+    double px = M_PI * x;
+    return 3 * qSin(px) * qSin(px / 3) / (px * px);
+  }
+
+  // Triangle (bilinear)
+  return x < 1 ? 1 - x : 0;
+}
+
+//
+// Taps
+// Weights to resample one axis from `from` samples to `to`. Output i 
+// reads count samples from first[i] on, with weights[i * count + k].
+//
+struct Taps {
+  Taps(int from, int to, Mode mode) {
+    double scale = double(to) / from;
+
+    // Shrinking widens the kernel so every source sample contributes
+    double stretch = qMax(1.0, 1 / scale);
+    double radius = (mode == Lanczos ? 3 : 1) * stretch;
+
+    count = qMin(from, qCeil(radius * 2) + 1);
+    first.resize(to);
+    weights.fill(0, to * count);
+
+    for (int i = 0; i < to; i++) {
+      double center = (i + 0.5) / scale;
+      int start = qBound(0, qFloor(center - radius), from - count);
+      float* w = weights.data() + i * count;
+
+      double sum = 0;
+      for (int k = 0; k < count; k++) {
+        w[k] = Kernel((start + k + 0.5 - center) / stretch, mode);
+        sum += w[k];
+      }
+
+      if (sum <= 0) {
+        // Can't happen with these kernels, but never divide by zero
+        int nearest = qBound(0, int(center) - start, count - 1);
+        w[nearest] = 1;
+        sum = 1;
+      }
+
+      for (int k = 0; k < count; k++)
+        w[k] /= sum;
+
+      first[i] = start;
+    }
+  }
+
+  int count;
+  QVector<int> first;
+  QVector<float> weights;
+};
+
+static inline int Clamp(float value, int max) {
+  int i = int(value + 0.5f);
+  return i < 0 ? 0 : (i > max ? max : i);
+}
+
+class HorizontalJob : public RowJob {
+ public:
+  HorizontalJob(const QImage& source, const Taps& taps, float* middle, 
+      int width) 
+      : in_(source), taps_(taps), middle_(middle), width_(width) {}
+
+ protected:
+  void Rows(int first, int last) {
+    std::vector<float> row(in_.width * 4);
+    const int count = taps_.count;
+
+    for (int y = first; y < last; y++) {
+      const QRgb* in = in_.Row(y);
+      for (int x = 0; x < in_.width; x++) {
+        row[x * 4] = qRed(in[x]);
+        row[x * 4 + 1] = qGreen(in[x]);
+        row[x * 4 + 2] = qBlue(in[x]);
+        row[x * 4 + 3] = qAlpha(in[x]);
+      }
+
+      float* out = middle_ + size_t(y) * width_ * 4;
+      for (int x = 0; x < width_; x++) {
+        const float* w = taps_.weights.constData() + x * count;
+        const float* p = &row[taps_.first[x] * 4];
+        float r = 0, g = 0, b = 0, a = 0;
+
+        for (int k = 0; k < count; k++) {
+          r += w[k] * p[k * 4];
+          g += w[k] * p[k * 4 + 1];
+          b += w[k] * p[k * 4 + 2];
+          a += w[k] * p[k * 4 + 3];
+        }
+
+        out[x * 4] = r;
+        out[x * 4 + 1] = g;
+        out[x * 4 + 2] = b;
+        out[x * 4 + 3] = a;
+      }
+    }
+  }
+
+ private:
+  Plane in_;
+  const Taps& taps_;
+  float* middle_;
+  int width_;
+};
+
+class VerticalJob : public RowJob {
+ public:
+  VerticalJob(const float* middle, const Taps& taps, QImage* target) 
+      : middle_(middle), taps_(taps), out_(Detached(target)) {}
+
+ protected:
+  void Rows(int first, int last) {
+    const size_t stride = size_t(out_.width) * 4;
+    const int count = taps_.count;
+    std::vector<float> sum(stride);
+
+    for (int y = first; y < last; y++) {
+      const float* w = taps_.weights.constData() + y * count;
+      std::fill(sum.begin(), sum.end(), 0.f);
+
+      for (int k = 0; k < count; k++) {
+        if (w[k] == 0)
+          continue;
+
+        const float* in = middle_ + (taps_.first[y] + k) * stride;
+        float* s = &sum[0];
+        const float weight = w[k];
+        for (size_t i = 0; i < stride; i++)
+          s[i] += weight * in[i];
+      }
+
+      // Ringing may overshoot; keep channels within alpha
+      QRgb* out = out_.Row(y);
+      for (int x = 0; x < out_.width; x++) {
+        int a = Clamp(sum[x * 4 + 3], 255);
+        out[x] = qRgba(Clamp(sum[x * 4], a), Clamp(sum[x * 4 + 1], a), 
+                       Clamp(sum[x * 4 + 2], a), a);
+      }
+    }
+  }
+
+ private:
+  const float* middle_;
+  const Taps& taps_;
+  Plane out_;
+};
+
+QImage Scaled(const QImage& image, const QSize& size, Mode mode) {
+  if (image.isNull() || size.isEmpty())
+    return QImage();
+
+  QImage source = Working(image, mode);
+  QImage::Format format = ResultFormat(image);
+
+  if (mode == Fast) {
+    // Same pixels, in the source's own format when it is 32-bit
+    QImage result(size, format);
+    if (result.isNull())
+      return result;
+
+    NearestJob job(source, &result);
+    job.Start(size.height());
+    return result;
+  }
+
+  // Filled as premultiplied ARGB, which RGB32 is too
+  QImage result(size, format == QImage::Format_RGB32 ? 
+      QImage::Format_RGB32 : QImage::Format_ARGB32_Premultiplied);
+  if (result.isNull())
+    return result;
+
+  Taps horizontal(image.width(), size.width(), mode);
+  Taps vertical(image.height(), size.height(), mode);
+  std::vector<float> middle(size_t(image.height()) * size.width() * 4);
+
+  HorizontalJob across(source, horizontal, &middle[0], size.width());
+  across.Start(image.height());
+
+  VerticalJob down(&middle[0], vertical, &result);
+  down.Start(size.height());
+
+  if (format == QImage::Format_ARGB32)
+    return result.convertToFormat(format);
+  return result;
+}
+
+//
+// Transformed
+//
+
+// Blends four premultiplied pixels; wx and wy are 0-256
+static inline QRgb Bilinear(QRgb p00, QRgb p10, QRgb p01, QRgb p11, 
+    int wx, int wy) {
+  QRgb result = 0;
+
+  for (int shift = 0; shift < 32; shift += 8) {
+    int top = ((p00 >> shift) & 0xff) * (256 - wx) + 
+              ((p10 >> shift) & 0xff) * wx;
+    int bottom = ((p01 >> shift) & 0xff) * (256 - wx) + 
+                 ((p11 >> shift) & 0xff) * wx;
+    int value = (top * (256 - wy) + bottom * wy + (1 << 15)) >> 16;
+    result |= QRgb(value) << shift;
+  }
+
+  return result;
+}
+
+class TransformJob : public RowJob {
+ public:
+  // inverse maps target pixels, offset by origin, back onto the source
+  TransformJob(const QImage& source, QImage* target, 
+      const QTransform& inverse, const QPoint& origin, bool smooth) 
+      : in_(source), out_(Detached(target)), inverse_(inverse), 
+        origin_(origin), smooth_(smooth) {
+    step_x_ = qSqrt(inverse.m11() * inverse.m11() + 
+                    inverse.m21() * inverse.m21());
+    step_y_ = qSqrt(inverse.m12() * inverse.m12() + 
+                    inverse.m22() * inverse.m22());
+    if (step_x_ <= 0)
+      step_x_ = 1;
+    if (step_y_ <= 0)
+      step_y_ = 1;
+  }
+
+ protected:
+  void Rows(int first, int last) {
+    const double m11 = inverse_.m11(), m12 = inverse_.m12(), 
+        m13 = inverse_.m13(), m21 = inverse_.m21(), m22 = inverse_.m22(), 
+        m23 = inverse_.m23(), m31 = inverse_.m31(), m32 = inverse_.m32(), 
+        m33 = inverse_.m33();
+    const bool affine = inverse_.isAffine();
+
+    for (int y = first; y < last; y++) {
+      QRgb* out = out_.Row(y);
+      double py = y + origin_.y() + 0.5;
+
+      for (int x = 0; x < out_.width; x++) {
+        double px = x + origin_.x() + 0.5;
+        double sx = m11 * px + m21 * py + m31;
+        double sy = m12 * px + m22 * py + m32;
+
+        if (!affine) {
+          double w = 1. / (m13 * px + m23 * py + m33);
+          sx *= w;
+          sy *= w;
+        }
+
+        out[x] = smooth_ ? Smooth(sx, sy) : Nearest(sx, sy);
+      }
+    }
+  }
+
+ private:
+  // Transparent outside the source
+  QRgb Pixel(int x, int y) const {
+    if (x < 0 || y < 0 || x >= in_.width || y >= in_.height)
+      return 0;
+    return in_.Row(y)[x];
+  }
+
+  QRgb Nearest(double x, double y) const {
+    return Pixel(qFloor(x), qFloor(y));
+  }
+
+  // Bilinear, clamped to the source's edge pixels, times the fraction of 
+  // the target pixel the source covers. Coverage comes from the distance 
+  // to the nearest source edge measured in target pixels, so edges are 
+  // antialiased but the borders of upscaled images aren't darkened.
+  QRgb Smooth(double x, double y) const {
+    double cx = qBound(0.0, qMin(x, in_.width - x) / step_x_ + 0.5, 1.0);
+    double cy = qBound(0.0, qMin(y, in_.height - y) / step_y_ + 0.5, 1.0);
+    if (cx <= 0 || cy <= 0)
+      return 0;
+
+    x -= 0.5;
+    y -= 0.5;
+    int x0 = qFloor(x), y0 = qFloor(y);
+    int wx = int((x - x0) * 256), wy = int((y - y0) * 256);
+
+    int left = qBound(0, x0, in_.width - 1);
+    int right = qBound(0, x0 + 1, in_.width - 1);
+    const QRgb* top = in_.Row(qBound(0, y0, in_.height - 1));
+    const QRgb* bottom = in_.Row(qBound(0, y0 + 1, in_.height - 1));
+
+    QRgb pixel = Bilinear(top[left], top[right], bottom[left], 
+                          bottom[right], wx, wy);
+
+    int coverage = int(cx * cy * 256 + 0.5);
+    if (coverage >= 256)
+      return pixel;
+
+    QRgb result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      int value = (((pixel >> shift) & 0xff) * coverage + 128) >> 8;
+      result |= QRgb(value) << shift;
+    }
+    return result;
+  }
+
+  Plane in_, out_;
+  QTransform inverse_;
+  QPoint origin_;
+  bool smooth_;
+
+  // Source distance covered by one target pixel, along each source axis
+  double step_x_, step_y_;
+};
+
+QImage Transformed(const QImage& image, const QTransform& transform, 
+    Mode mode) {
+  if (image.isNull())
+    return QImage();
+
+  // Move the result's bounding rect to the origin, like QImage does
+  QTransform t = QImage::trueMatrix(transform, image.width(), 
+      image.height());
+  QRect bounds = t.mapRect(QRectF(image.rect())).toAlignedRect();
+
+  bool invertible;
+  QTransform inverse = t.inverted(&invertible);
+  if (!invertible || bounds.isEmpty())
+    return QImage();
+
+  QImage source = Working(image, mode);
+
+  // Nearest neighbour samples ARGB32 as is; transparent is 0 either way
+  bool raw_argb = mode == Fast && source.format() == QImage::Format_ARGB32;
+  QImage result(bounds.size(), raw_argb ? 
+      QImage::Format_ARGB32 : QImage::Format_ARGB32_Premultiplied);
+  if (result.isNull())
+    return result;
+
+  TransformJob job(source, &result, inverse, bounds.topLeft(), 
+      mode != Fast);
+  job.Start(result.height());
+
+  if (!raw_argb && image.format() == QImage::Format_ARGB32)
+    return result.convertToFormat(QImage::Format_ARGB32);
+  return result;
+}
+
+//
+// Arguments
+//
+
+// Reads options.mode; no options or no mode means Fast
+static bool ReadMode(Local<Value> options, Mode* mode) {
+  *mode = Fast;
+
+  if (!options->IsObject())
+    return options->IsUndefined();
+
+  Local<Value> value = Nan::Get(options->ToObject(), 
+      Nan::New("mode").ToLocalChecked()).ToLocalChecked();
+  if (value->IsUndefined())
+    return true;
+  if (!value->IsString())
+    return false;
+
+  QString name = qt_v8::ToQString(value->ToString());
+  if (name == "fast")
+    *mode = Fast;
+  else if (name == "smooth")
+    *mode = Smooth;
+  else if (name == "lanczos")
+    *mode = Lanczos;
+  else
+    return false;
+
+  return true;
+}
+
+bool ReadScaleArguments(Nan::NAN_METHOD_ARGS_TYPE info, const QSize& from, 
+    QSize* size, Mode* mode, QString* error) {
+  if (!info[0]->IsNumber() || !info[1]->IsNumber()) {
+    *error = "bad arguments";
+    return false;
+  }
+
+  if (!ReadMode(info[2], mode)) {
+    *error = "options.mode must be 'fast', 'smooth' or 'lanczos'";
+    return false;
+  }
+
+  *size = QSize(info[0]->Int32Value(), info[1]->Int32Value());
+
+  if (info[2]->IsObject()) {
+    Local<Value> aspect = Nan::Get(info[2]->ToObject(), 
+        Nan::New("aspectRatioMode").ToLocalChecked()).ToLocalChecked();
+
+    if (aspect->IsNumber() && !size->isEmpty()) {
+      QSize scaled(from);
+      scaled.scale(*size, (Qt::AspectRatioMode)aspect->Int32Value());
+      *size = scaled;
+    }
+  }
+
+  return true;
+}
+
+bool ReadTransformArguments(Nan::NAN_METHOD_ARGS_TYPE info, 
+    QTransform* transform, Mode* mode, QString* error) {
+  if (qt_v8::HasTag(info[0], &QTransformWrap::prototype)) {
+    *transform = *node::ObjectWrap::Unwrap<QTransformWrap>(
+        info[0]->ToObject())->GetWrapped();
+  } else if (qt_v8::HasTag(info[0], &QMatrixWrap::prototype)) {
+    *transform = QTransform(*node::ObjectWrap::Unwrap<QMatrixWrap>(
+        info[0]->ToObject())->GetWrapped());
+  } else {
+    *error = "bad arguments";
+    return false;
+  }
+
+  if (!ReadMode(info[1], mode) || *mode == Lanczos) {
+    *error = "options.mode must be 'fast' or 'smooth'";
+    return false;
+  }
+
+  return true;
+}
+
+//
+// Worker
+//
+
+Worker::Worker(Nan::Callback* callback, const QImage& image, 
+    const QSize& size, Mode mode) 
+    : Nan::AsyncWorker(callback), image_(image), size_(size), 
+      transformed_(false), mode_(mode) {
+}
+
+Worker::Worker(Nan::Callback* callback, const QImage& image, 
+    const QTransform& transform, Mode mode) 
+    : Nan::AsyncWorker(callback), image_(image), transform_(transform), 
+      transformed_(true), mode_(mode) {
+}
+
+void Worker::Execute() {
+  result_ = transformed_ ? 
+      Transformed(image_, transform_, mode_) : Scaled(image_, size_, mode_);
+}
+
+void Worker::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  Local<Value> argv[] = { Nan::Null(), QImageWrap::NewInstance(result_) };
+  callback->Call(2, argv);
+}
+
+} // namespace
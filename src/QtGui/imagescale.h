@@ -0,0 +1,100 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <QImage>
+#include <QTransform>
+
+//
+// imagescale
+// Resampling behind QImage/QPixmap.scaled() and transformed(). Work is 
+// split into bands of rows run on the global QThreadPool (see 
+// qt_parallel.h), so it may be called from the main thread or a libuv 
+// worker.
+//
+namespace imagescale {
+
+enum Mode {
+  Fast,     // nearest neighbour
+  Smooth,   // bilinear, area-averaging when shrinking
+  Lanczos   // Lanczos-3, windowed sinc; scaled() only
+};
+
+// Returns image resampled to size, or a null image if size is empty.
+// The result keeps image's format if it's 32-bit, otherwise it is 
+// Format_ARGB32_Premultiplied or Format_RGB32.
+QImage Scaled(const QImage& image, const QSize& size, Mode mode);
+
+// Returns image mapped through transform, positioned like 
+// QImage::transformed(): its bounding rect moved to the origin. Pixels 
+// outside the source are transparent.
+QImage Transformed(const QImage& image, const QTransform& transform, 
+    Mode mode);
+
+// Argument readers shared by the QImage and QPixmap bindings. On failure
+// they return false and set error.
+
+// ( int width, int height, { mode, aspectRatioMode } options )
+bool ReadScaleArguments(Nan::NAN_METHOD_ARGS_TYPE info, const QSize& from, 
+    QSize* size, Mode* mode, QString* error);
+
+// ( QTransform|QMatrix transform, { mode } options )
+bool ReadTransformArguments(Nan::NAN_METHOD_ARGS_TYPE info, 
+    QTransform* transform, Mode* mode, QString* error);
+
+//
+// Worker
+// Runs Scaled() or Transformed() on the libuv threadpool and calls back 
+// with a new QImage
+//
+class Worker : public Nan::AsyncWorker {
+ public:
+  Worker(Nan::Callback* callback, const QImage& image, const QSize& size, 
+      Mode mode);
+  Worker(Nan::Callback* callback, const QImage& image, 
+      const QTransform& transform, Mode mode);
+
+  void Execute();
+
+ protected:
+  void HandleOKCallback();
+
+ private:
+  QImage image_;
+  QSize size_;
+  QTransform transform_;
+  bool transformed_;
+  Mode mode_;
+  QImage result_;
+};
+
+} // namespace
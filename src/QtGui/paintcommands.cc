@@ -0,0 +1,306 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits.h>
+#include <string.h>
+#include "../qt_v8.h"
+#include "paintcommands.h"
+#include "qpixmap.h"
+#include "qimage.h"
+#include "qpen.h"
+
+using namespace v8;
+
+// Number of arguments following each opcode, indexed by PaintCommands::Op
+static const int kArity[PaintCommands::LastOp + 1] = {
+  0,  // (unused)
+  0,  // Save
+  0,  // Restore
+  5,  // FillRect
+  3,  // DrawText
+  3,  // DrawPixmap
+  1,  // SetPen
+  6   // SetMatrix
+};
+
+// Float64Array streams may hold NaN, infinities or values out of int 
+// range, which can't be cast; Int32Array values always fit
+static inline bool ToInt(int32_t value, int* out) {
+  *out = value;
+  return true;
+}
+
+static inline bool ToInt(double value, int* out) {
+  if (!(value >= INT_MIN && value <= INT_MAX))
+    return false;
+  *out = (int)value;
+  return true;
+}
+
+// Colors travel as 0xAARRGGBB; Int32Array streams hold them sign-wrapped
+static inline bool ToRgb(int32_t value, QRgb* out) {
+  *out = (QRgb)(quint32)value;
+  return true;
+}
+
+static inline bool ToRgb(double value, QRgb* out) {
+  if (!(value >= INT_MIN && value <= 0xffffffffu))
+    return false;
+  *out = (QRgb)(quint32)(qint64)value;
+  return true;
+}
+
+// Undoes the save()s of a stream that failed part way through
+static bool Unwind(QPainter* painter, int saves) {
+  while (saves-- > 0)
+    painter->restore();
+  return false;
+}
+
+PaintCommands::PaintCommands() : ops_(NULL), count_(0), int32_(false) {
+}
+
+bool PaintCommands::Parse(Local<Value> ops, Local<Value> strings,
+                          Local<Value> resources, QString* error) {
+  if (ops->IsFloat64Array()) {
+    Nan::TypedArrayContents<double> contents(ops);
+    ops_ = *contents;
+    count_ = contents.length();
+    int32_ = false;
+  } else if (ops->IsInt32Array()) {
+    Nan::TypedArrayContents<int32_t> contents(ops);
+    ops_ = *contents;
+    count_ = contents.length();
+    int32_ = true;
+  } else {
+    *error = "commands must be a Float64Array or Int32Array";
+    return false;
+  }
+
+  if (strings->IsArray()) {
+    Local<Array> array = Local<Array>::Cast(strings);
+    strings_.resize(array->Length());
+    for (uint32_t i = 0; i < array->Length(); i++) {
+      strings_[i] = qt_v8::ToQString(
+          Nan::Get(array, i).ToLocalChecked()->ToString());
+    }
+  } else if (!strings->IsUndefined() && !strings->IsNull()) {
+    *error = "strings must be an array";
+    return false;
+  }
+
+  if (resources->IsArray()) {
+    Local<Array> array = Local<Array>::Cast(resources);
+    int length = array->Length();
+    kinds_.fill(None, length);
+    pixmaps_.resize(length);
+    images_.resize(length);
+    pens_.resize(length);
+
+    for (int i = 0; i < length; i++) {
+      Local<Value> value = Nan::Get(array, i).ToLocalChecked();
+
+      if (qt_v8::HasTag(value, &QPixmapWrap::prototype)) {
+        kinds_[i] = Pixmap;
+        pixmaps_[i] = *ObjectWrap::Unwrap<QPixmapWrap>(
+            value->ToObject())->GetWrapped();
+      } else if (qt_v8::HasTag(value, &QImageWrap::prototype)) {
+        kinds_[i] = Image;
+        images_[i] = *ObjectWrap::Unwrap<QImageWrap>(
+            value->ToObject())->GetWrapped();
+      } else if (qt_v8::HasTag(value, &QPenWrap::prototype)) {
+        kinds_[i] = Pen;
+        pens_[i] = *ObjectWrap::Unwrap<QPenWrap>(
+            value->ToObject())->GetWrapped();
+      }
+    }
+  } else if (!resources->IsUndefined() && !resources->IsNull()) {
+    *error = "resources must be an array";
+    return false;
+  }
+
+  return true;
+}
+
+void PaintCommands::ConvertPixmapsToImages() {
+  for (int i = 0; i < kinds_.size(); i++) {
+    if (kinds_[i] == Pixmap) {
+      images_[i] = pixmaps_[i].toImage();
+      pixmaps_[i] = QPixmap();
+      kinds_[i] = Image;
+    }
+  }
+}
+
+void PaintCommands::CopyOps() {
+  if (int32_) {
+    int32_ops_.resize(count_);
+    memcpy(int32_ops_.data(), ops_, count_ * sizeof(int32_t));
+    ops_ = int32_ops_.constData();
+  } else {
+    double_ops_.resize(count_);
+    memcpy(double_ops_.data(), ops_, count_ * sizeof(double));
+    ops_ = double_ops_.constData();
+  }
+}
+
+bool PaintCommands::Replay(QPainter* painter, QString* error) const {
+  if (int32_)
+    return ReplayOps(painter, static_cast<const int32_t*>(ops_), count_, error);
+
+  return ReplayOps(painter, static_cast<const double*>(ops_), count_, error);
+}
+
+// Stops at the first bad opcode; Replay() rejects the stream there
+template <typename T>
+static bool HasOp(const T* ops, int count, int wanted) {
+  int i = 0;
+
+  while (i < count) {
+    if (!(ops[i] >= 1 && ops[i] <= PaintCommands::LastOp))
+      return false;
+
+    int op = (int)ops[i];
+    if (op == wanted)
+      return true;
+
+    i += 1 + kArity[op];
+  }
+
+  return false;
+}
+
+bool PaintCommands::DrawsText() const {
+  if (int32_)
+    return HasOp(static_cast<const int32_t*>(ops_), count_, DrawText);
+
+  return HasOp(static_cast<const double*>(ops_), count_, DrawText);
+}
+
+template <typename T>
+bool PaintCommands::ReplayOps(QPainter* painter, const T* ops, int count,
+                              QString* error) const {
+  int i = 0;
+  int saves = 0;
+
+  while (i < count) {
+    if (!(ops[i] >= 1 && ops[i] <= LastOp)) {
+      *error = QString("unknown opcode %1 at index %2")
+          .arg((double)ops[i]).arg(i);
+      return Unwind(painter, saves);
+    }
+
+    int op = (int)ops[i];
+
+    if (i + 1 + kArity[op] > count) {
+      *error = QString("truncated command at index %1").arg(i);
+      return Unwind(painter, saves);
+    }
+
+    const T* a = ops + i + 1;
+
+    // Integer arguments; SetMatrix takes reals and FillRect ends in a color
+    int n[5];
+    int ints = op == SetMatrix ? 0 : (op == FillRect ? 4 : kArity[op]);
+    for (int k = 0; k < ints; k++) {
+      if (!ToInt(a[k], &n[k])) {
+        *error = QString("bad argument at index %1").arg(i + 1 + k);
+        return Unwind(painter, saves);
+      }
+    }
+
+    switch (op) {
+      case Save:
+        painter->save();
+        saves++;
+        break;
+
+      case Restore:
+        painter->restore();
+        if (saves > 0)
+          saves--;
+        break;
+
+      case FillRect: {
+        QRgb rgba;
+        if (!ToRgb(a[4], &rgba)) {
+          *error = QString("bad color at index %1").arg(i + 5);
+          return Unwind(painter, saves);
+        }
+        painter->fillRect(n[0], n[1], n[2], n[3], QColor::fromRgba(rgba));
+        break;
+      }
+
+      case DrawText: {
+        int index = n[2];
+        if (index < 0 || index >= strings_.size()) {
+          *error = QString("bad string index %1 at index %2").arg(index).arg(i);
+          return Unwind(painter, saves);
+        }
+        painter->drawText(n[0], n[1], strings_[index]);
+        break;
+      }
+
+      case DrawPixmap: {
+        int index = n[2];
+        int kind = (index >= 0 && index < kinds_.size()) ? kinds_[index] : None;
+        if (kind == Pixmap) {
+          painter->drawPixmap(n[0], n[1], pixmaps_[index]);
+        } else if (kind == Image) {
+          painter->drawImage(n[0], n[1], images_[index]);
+        } else {
+          *error = QString("resource %1 at index %2 is not a QPixmap or QImage")
+              .arg(index).arg(i);
+          return Unwind(painter, saves);
+        }
+        break;
+      }
+
+      case SetPen: {
+        int index = n[0];
+        if (index < 0 || index >= kinds_.size() || kinds_[index] != Pen) {
+          *error = QString("resource %1 at index %2 is not a QPen")
+              .arg(index).arg(i);
+          return Unwind(painter, saves);
+        }
+        painter->setPen(pens_[index]);
+        break;
+      }
+
+      case SetMatrix:
+        painter->setWorldTransform(QTransform(a[0], a[1], a[2], a[3],
+                                              a[4], a[5]));
+        break;
+    }
+
+    i += 1 + kArity[op];
+  }
+
+  return true;
+}
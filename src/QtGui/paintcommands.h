@@ -0,0 +1,104 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <QPainter>
+#include <QVector>
+#include <QString>
+#include <QPixmap>
+#include <QImage>
+#include <QPen>
+
+//
+// PaintCommands
+// Decoded form of the command stream accepted by QPainter.execute(). The
+// stream is a Float64Array or Int32Array of [opcode, args...] records, so a
+// whole frame can be replayed with a single JS->C++ crossing. Opcodes are
+// exported to JS as qt.QPainter.Op (see lib/qt.js).
+//
+class PaintCommands {
+ public:
+  enum Op {
+    Save = 1,        // save()
+    Restore = 2,     // restore()
+    FillRect = 3,    // fillRect(x, y, w, h, 0xAARRGGBB)
+    DrawText = 4,    // drawText(x, y, strings[index])
+    DrawPixmap = 5,  // drawPixmap(x, y, resources[index])
+    SetPen = 6,      // setPen(resources[index])
+    SetMatrix = 7,   // setMatrix(m11, m12, m21, m22, dx, dy)
+    LastOp = SetMatrix
+  };
+
+  PaintCommands();
+
+  // Reads the command stream and its string/resource tables. Only the
+  // stream itself is required. The typed array is not copied, so the
+  // commands must be replayed before returning to JS, unless CopyOps() 
+  // was called.
+  bool Parse(v8::Local<v8::Value> ops, v8::Local<v8::Value> strings,
+             v8::Local<v8::Value> resources, QString* error);
+
+  bool Replay(QPainter* painter, QString* error) const;
+
+  // Whether the stream has DrawText commands, which need threaded font
+  // rendering to replay off the GUI thread
+  bool DrawsText() const;
+
+  // QPixmaps may live in the window system and can't be used off the GUI
+  // thread. Call this before replaying on worker threads.
+  void ConvertPixmapsToImages();
+
+  // Takes a private copy of the stream, for replays that may overlap JS 
+  // code changing or detaching the typed array
+  void CopyOps();
+
+ private:
+  enum ResourceKind { None, Pixmap, Image, Pen };
+
+  template <typename T>
+  bool ReplayOps(QPainter* painter, const T* ops, int count,
+                 QString* error) const;
+
+  const void* ops_;
+  int count_;
+  bool int32_;
+
+  // Own copies of the stream, see CopyOps()
+  QVector<double> double_ops_;
+  QVector<int32_t> int32_ops_;
+
+  QVector<QString> strings_;
+  QVector<int> kinds_;
+  QVector<QPixmap> pixmaps_;
+  QVector<QImage> images_;
+  QVector<QPen> pens_;
+};
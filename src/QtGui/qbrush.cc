@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qbrush.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QBrushWrap::prototype;
-Nan::Persistent<Function> QBrushWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QBrushWrap::prototype;
+qt_v8::PerIsolate<Function> QBrushWrap::constructor;
 
 // Supported constructors
 // QBrush(Qt::GlobalColor)  
@@ -53,7 +54,7 @@ NAN_MODULE_INIT(QBrushWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QBrush").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
 
@@ -66,4 +67,5 @@ NAN_MODULE_INIT(QBrushWrap::Initialize) {
 NAN_METHOD(QBrushWrap::New) {
   QBrushWrap* w = new QBrushWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
@@ -32,8 +32,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QColorWrap::prototype;
-Nan::Persistent<Function> QColorWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QColorWrap::prototype;
+qt_v8::PerIsolate<Function> QColorWrap::constructor;
 
 // Supported implementations:
 //   QColor ( int r, int g, int b, int a = 255 )
@@ -53,12 +53,12 @@ QColorWrap::QColorWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
     q_ = new QColor(qt_v8::ToQString(info[0]->ToString()));
   } else if (info[0]->IsObject()) {
     // QColor ( QColor color )
-    QString arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-
-    if (arg0_constructor != "QColor")
+    if (!qt_v8::HasTag(info[0], &QColorWrap::prototype)) {
       Nan::ThrowError(Exception::TypeError(
         Nan::New("QColor::QColor: bad argument").ToLocalChecked()));
+      q_ = new QColor();
+      return;
+    }
 
     // Unwrap obj
     QColorWrap* q_wrap = ObjectWrap::Unwrap<QColorWrap>(
@@ -77,7 +77,7 @@ NAN_MODULE_INIT(QColorWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QColor").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "red", Red);
@@ -95,6 +95,7 @@ NAN_MODULE_INIT(QColorWrap::Initialize) {
 NAN_METHOD(QColorWrap::New) {
   QColorWrap* w = new QColorWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QColorWrap::Red) {
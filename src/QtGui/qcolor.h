@@ -31,16 +31,17 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QColor>
 
 class QColorWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QColor* GetWrapped() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QColorWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QColorWrap();
   static NAN_METHOD(New);
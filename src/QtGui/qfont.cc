@@ -32,8 +32,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QFontWrap::prototype;
-Nan::Persistent<Function> QFontWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QFontWrap::prototype;
+qt_v8::PerIsolate<Function> QFontWrap::constructor;
 
 // Supported implementations:
 //   QFont ( )
@@ -51,12 +51,12 @@ QFontWrap::QFontWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
   // QFont ( QFont font )
 
   if (info.Length() == 1 && info[0]->IsObject()) {
-    QString arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-
-    if (arg0_constructor != "QFont")
+    if (!qt_v8::HasTag(info[0], &QFontWrap::prototype)) {
       Nan::ThrowError(Exception::TypeError(
         Nan::New("QFont::QFont: bad argument").ToLocalChecked()));
+      q_ = new QFont();
+      return;
+    }
 
     // Unwrap obj
     QFontWrap* q_wrap = ObjectWrap::Unwrap<QFontWrap>(
@@ -102,7 +102,7 @@ NAN_MODULE_INIT(QFontWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QFont").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "setFamily", SetFamily);
@@ -123,12 +123,13 @@ NAN_MODULE_INIT(QFontWrap::Initialize) {
 NAN_METHOD(QFontWrap::New) {
   QFontWrap* w = new QFontWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QFontWrap::NewInstance(QFont q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QFontWrap* w = node::ObjectWrap::Unwrap<QFontWrap>(instance);
   w->SetWrapped(q);
 
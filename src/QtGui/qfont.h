@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QFont>
 
 class QFontWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QFont* GetWrapped() const { return q_; };
   void SetWrapped(QFont q) { 
@@ -45,7 +46,7 @@ class QFontWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QFont q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QFontWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QFontWrap();
   static NAN_METHOD(New);
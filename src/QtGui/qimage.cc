@@ -27,50 +27,190 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <node_buffer.h>
 #include "qimage.h"
+#include "qimageio.h"
+#include "imagescale.h"
 #include "../qt_v8.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QImageWrap::prototype;
-Nan::Persistent<Function> QImageWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QImageWrap::prototype;
+qt_v8::PerIsolate<Function> QImageWrap::constructor;
 
 // Supported implementations:
 //   QImage ( )
 //   QImage ( QString filename )
-QImageWrap::QImageWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
+//   QImage ( Buffer data, QString format = null )
+//   QImage ( Buffer pixels, int width, int height, int bytesPerLine, 
+//       QImage::Format format )
+//   QImage ( int width, int height, QImage::Format format )
+QImageWrap::QImageWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
+  if (info[0]->IsNumber()) {
+    // QImage ( int width, int height, QImage::Format format )
+    // Cleared to transparent black rather than left uninitialized
+    int format = info[2]->Int32Value();
+
+    if (!info[1]->IsNumber() || !IsFormat(format)) {
+      Nan::ThrowError(Exception::TypeError(
+          Nan::New("QImage::QImage: bad arguments").ToLocalChecked()));
+      q_ = new QImage();
+      return;
+    }
+
+    q_ = new QImage(info[0]->Int32Value(), info[1]->Int32Value(), 
+        static_cast<QImage::Format>(format));
+    if (!q_->isNull())
+      q_->fill(0);
+    return;
+  }
+
   if (info[0]->IsString()) {
     // QImage ( QString filename ) 
     q_ = new QImage(qt_v8::ToQString(info[0]->ToString()));
     return;
   }
 
+  if (node::Buffer::HasInstance(info[0]) && info.Length() >= 5) {
+    // QImage ( Buffer pixels, int width, int height, int bytesPerLine, 
+    //   QImage::Format format )
+    QString error;
+    QImage image = FromPixels(info[0], info[1]->IntegerValue(), 
+        info[2]->IntegerValue(), info[3]->IntegerValue(), 
+        info[4]->IntegerValue(), &error);
+
+    if (!error.isEmpty()) {
+      Nan::ThrowError(Exception::TypeError(
+          qt_v8::FromQString("QImage::QImage: " + error)));
+    }
+
+    // Keep the pixels alive for as long as q_ may point into them
+    if (!image.isNull() && image.constBits() == 
+        reinterpret_cast<const uchar*>(node::Buffer::Data(info[0])))
+      source_.Reset(info[0]->ToObject());
+
+    q_ = new QImage(image);
+    return;
+  }
+
+  if (node::Buffer::HasInstance(info[0])) {
+    // QImage ( Buffer data, QString format = null )
+    q_ = new QImage();
+
+    QByteArray format;
+    if (info[1]->IsString())
+      format = qt_v8::ToQString(info[1]->ToString()).toLatin1();
+
+    q_->loadFromData(
+        reinterpret_cast<const uchar*>(node::Buffer::Data(info[0])),
+        node::Buffer::Length(info[0]), 
+        format.isEmpty() ? NULL : format.constData());
+    return;
+  }
+
   // QImage ( )
-  q_ = new QImage(qt_v8::ToQString(info[0]->ToString()));  
+  q_ = new QImage();
 }
 
 QImageWrap::~QImageWrap() {
   delete q_;
+  owner_ = QImage();
+  source_.Reset();
+}
+
+bool QImageWrap::IsFormat(int format) {
+  return format > QImage::Format_Invalid && format < QImage::NImageFormats;
+}
+
+QImage QImageWrap::FromPixels(Local<Value> buffer, int width, int height, 
+    int bytesPerLine, int format, QString* error) {
+  if (!node::Buffer::HasInstance(buffer)) {
+    *error = "pixels must be a Buffer";
+    return QImage();
+  }
+
+  if (!IsFormat(format)) {
+    *error = "unknown format";
+    return QImage();
+  }
+
+  if (width <= 0 || height <= 0 || bytesPerLine <= 0) {
+    *error = "bad dimensions";
+    return QImage();
+  }
+
+  uchar* data = reinterpret_cast<uchar*>(node::Buffer::Data(buffer));
+  size_t length = node::Buffer::Length(buffer);
+
+  if (length < static_cast<size_t>(bytesPerLine) * height) {
+    *error = "Buffer is too small";
+    return QImage();
+  }
+
+  QImage::Format f = static_cast<QImage::Format>(format);
+
+  // QImage requires 32-bit aligned scanlines. Buffers sliced at odd offsets
+  // can't be aliased, so those are copied instead.
+  bool aligned = (reinterpret_cast<quintptr>(data) & 3) == 0 && 
+      (bytesPerLine & 3) == 0;
+
+  QImage view(data, width, height, bytesPerLine, f);
+  if (view.isNull()) {
+    *error = "bytesPerLine is too small for width and format";
+    return QImage();
+  }
+
+  return aligned ? view : view.copy();
 }
 
 NAN_MODULE_INIT(QImageWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QImage").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "isNull", IsNull);
+  Nan::SetPrototypeMethod(tpl, "width", Width);
+  Nan::SetPrototypeMethod(tpl, "height", Height);
+  Nan::SetPrototypeMethod(tpl, "format", Format);
+  Nan::SetPrototypeMethod(tpl, "bytesPerLine", BytesPerLine);
+  Nan::SetPrototypeMethod(tpl, "byteCount", ByteCount);
+  Nan::SetPrototypeMethod(tpl, "bits", Bits);
+  Nan::SetPrototypeMethod(tpl, "hasAlphaChannel", HasAlphaChannel);
+  Nan::SetPrototypeMethod(tpl, "convertToFormat", ConvertToFormat);
+  Nan::SetPrototypeMethod(tpl, "saveAsync", SaveAsync);
+  Nan::SetPrototypeMethod(tpl, "scaled", Scaled);
+  Nan::SetPrototypeMethod(tpl, "scaledAsync", ScaledAsync);
+  Nan::SetPrototypeMethod(tpl, "transformed", Transformed);
+  Nan::SetPrototypeMethod(tpl, "transformedAsync", TransformedAsync);
 
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
   constructor.Reset(function);
   Nan::Set(target, Nan::New("QImage").ToLocalChecked(), function);
+
+  // Static methods
+  Nan::SetMethod(function, "loadAsync", QImageIO::Load);
+  Nan::SetMethod(function, "cancelLoad", QImageIO::CancelLoad);
+  Nan::SetMethod(function, "setLoadConcurrency", 
+      QImageIO::SetLoadConcurrency);
 }
 
 NAN_METHOD(QImageWrap::New) {
   QImageWrap* w = new QImageWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+Handle<Value> QImageWrap::NewInstance(QImage q) {
+  Nan::EscapableHandleScope scope;
+  
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
+  QImageWrap* w = node::ObjectWrap::Unwrap<QImageWrap>(instance);
+  w->SetWrapped(q);
+
+  return scope.Escape(instance);
 }
 
 NAN_METHOD(QImageWrap::IsNull) {
@@ -79,3 +219,235 @@ NAN_METHOD(QImageWrap::IsNull) {
 
   info.GetReturnValue().Set(Nan::New(q->isNull()));
 }
+
+NAN_METHOD(QImageWrap::Width) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->width()));
+}
+
+NAN_METHOD(QImageWrap::Height) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->height()));
+}
+
+// Returns a QImage::Format value, see qt.QImage.Format
+NAN_METHOD(QImageWrap::Format) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(static_cast<int>(q->format())));
+}
+
+NAN_METHOD(QImageWrap::BytesPerLine) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->bytesPerLine()));
+}
+
+NAN_METHOD(QImageWrap::ByteCount) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->bytesPerLine() * q->height()));
+}
+
+// Makes sure the pixels of q_ live in owner_ and returns their address.
+//
+// Exported Buffers hold a shallow copy of owner_ (and the source Buffer, 
+// for images over raw pixels), so the memory outlives the wrapper if need 
+// be. q_ itself is rebound to a non-owning QImage over
+// the same memory: nothing else shares that view, so painting into the 
+// image writes through to the exported pixels instead of detaching from 
+// them. If q_ is later shared and detached (or replaced), the next bits() 
+// call exports the new pixels.
+uchar* QImageWrap::ExportBits() {
+  if (!owner_.isNull() && q_->constBits() == owner_.constBits())
+    return const_cast<uchar*>(owner_.constBits());
+
+  owner_ = *q_;
+  *q_ = QImage();
+
+  // Detach from any other QImage sharing these pixels (no-op otherwise)
+  uchar* bits = owner_.bits();
+
+  QImage view(bits, owner_.width(), owner_.height(), owner_.bytesPerLine(),
+      owner_.format());
+  view.setColorTable(owner_.colorTable());
+  view.setDotsPerMeterX(owner_.dotsPerMeterX());
+  view.setDotsPerMeterY(owner_.dotsPerMeterY());
+  *q_ = view;
+
+  return bits;
+}
+
+void QImageWrap::FreeBits(char* data, void* hint) {
+  ExportedBits* exported = static_cast<ExportedBits*>(hint);
+  exported->source.Reset();
+  delete exported;
+}
+
+// Supported implementations:
+//   bits ( )
+// Returns a Buffer aliasing the image's pixel memory (no copy), or null for
+// a null image. Rows are bytesPerLine() bytes apart; see format() for the
+// pixel layout.
+NAN_METHOD(QImageWrap::Bits) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+
+  if (w->GetWrapped()->isNull()) {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  uchar* bits = w->ExportBits();
+  ExportedBits* hint = new ExportedBits;
+  hint->image = w->owner_;
+  if (!w->source_.IsEmpty())
+    hint->source.Reset(Nan::New(w->source_));
+
+  size_t length = static_cast<size_t>(hint->image.bytesPerLine()) * 
+      hint->image.height();
+
+  info.GetReturnValue().Set(Nan::NewBuffer(reinterpret_cast<char*>(bits), 
+      length, FreeBits, hint).ToLocalChecked());
+}
+
+NAN_METHOD(QImageWrap::HasAlphaChannel) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->hasAlphaChannel()));
+}
+
+// Supported versions:
+//   convertToFormat( QImage::Format format )
+// Returns a new QImage. Converting assets once to the painter's native 
+// format (usually Format_ARGB32_Premultiplied) saves a conversion on every
+// drawImage().
+NAN_METHOD(QImageWrap::ConvertToFormat) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber() || !IsFormat(info[0]->Int32Value()))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QImage::ConvertToFormat: bad argument").ToLocalChecked()));
+
+  QImage::Format format = static_cast<QImage::Format>(info[0]->Int32Value());
+  QImage converted = q->convertToFormat(format);
+
+  // Already in that format: the result is a shallow copy of q
+  if (w->IsView() && converted.constBits() == q->constBits())
+    converted = converted.copy();
+
+  info.GetReturnValue().Set(NewInstance(converted));
+}
+
+// Encodes on the threadpool, see QImageIO::Save
+NAN_METHOD(QImageWrap::SaveAsync) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  QImageIO::Save(info, *q);
+}
+
+// Supported versions:
+//   scaled( int width, int height, Object options = {} )
+// options.mode is 'fast' (default), 'smooth' or 'lanczos'; 
+// options.aspectRatioMode is a qt.AspectRatioMode. Rows are resampled in 
+// parallel, see imagescale.h.
+NAN_METHOD(QImageWrap::Scaled) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  QSize size;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadScaleArguments(info, q->size(), &size, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QImage::Scaled: " + error)));
+
+  info.GetReturnValue().Set(NewInstance(imagescale::Scaled(*q, size, mode)));
+}
+
+// Supported versions:
+//   scaledAsync( int width, int height, Object options, Function callback )
+// As scaled(), on the libuv threadpool
+NAN_METHOD(QImageWrap::ScaledAsync) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  QSize size;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadScaleArguments(info, q->size(), &size, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QImage::ScaledAsync: " + error)));
+
+  if (!info[3]->IsFunction())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QImage::ScaledAsync: bad arguments").ToLocalChecked()));
+
+  imagescale::Worker* worker = new imagescale::Worker(
+      new Nan::Callback(info[3].As<Function>()), *q, size, mode);
+
+  // q may be a view onto memory owned by the wrapper
+  worker->SaveToPersistent("owner", info.This());
+
+  Nan::AsyncQueueWorker(worker);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   transformed( QTransform|QMatrix transform, Object options = {} )
+// options.mode is 'fast' (default) or 'smooth'. The result is the 
+// transform's bounding rect; uncovered pixels are transparent.
+NAN_METHOD(QImageWrap::Transformed) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  QTransform transform;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadTransformArguments(info, &transform, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QImage::Transformed: " + error)));
+
+  info.GetReturnValue().Set(
+      NewInstance(imagescale::Transformed(*q, transform, mode)));
+}
+
+// Supported versions:
+//   transformedAsync( QTransform|QMatrix transform, Object options, 
+//                     Function callback )
+// As transformed(), on the libuv threadpool
+NAN_METHOD(QImageWrap::TransformedAsync) {
+  QImageWrap* w = ObjectWrap::Unwrap<QImageWrap>(info.This());
+  QImage* q = w->GetWrapped();
+
+  QTransform transform;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadTransformArguments(info, &transform, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QImage::TransformedAsync: " + error)));
+
+  if (!info[2]->IsFunction())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QImage::TransformedAsync: bad arguments").ToLocalChecked()));
+
+  imagescale::Worker* worker = new imagescale::Worker(
+      new Nan::Callback(info[2].As<Function>()), *q, transform, mode);
+
+  // q may be a view onto memory owned by the wrapper
+  worker->SaveToPersistent("owner", info.This());
+
+  Nan::AsyncQueueWorker(worker);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
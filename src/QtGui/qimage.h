@@ -31,23 +31,76 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QImage>
 
 class QImageWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QImage* GetWrapped() const { return q_; };
+  void SetWrapped(QImage q) {
+    if (q_) delete q_;
+    q_ = new QImage(q);
+    owner_ = QImage();
+    source_.Reset();
+  };
+  static v8::Handle<v8::Value> NewInstance(QImage q);
+
+  // Returns a QImage over raw pixels in a Buffer, or a null QImage and an
+  // error message. The QImage aliases the Buffer memory when it can.
+  static QImage FromPixels(v8::Local<v8::Value> buffer, int width, 
+      int height, int bytesPerLine, int format, QString* error);
+
+  // Whether format is a valid QImage::Format in this Qt version
+  static bool IsFormat(int format);
+
+  // Whether q_ points into memory it doesn't own: pixels exported by 
+  // bits() or a Buffer passed to the constructor. Shallow copies of a view
+  // must not outlive the wrapper, so they need a deep copy().
+  bool IsView() const {
+    return (!owner_.isNull() && q_->constBits() == owner_.constBits()) || 
+        !source_.IsEmpty();
+  }
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QImageWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QImageWrap();
   static NAN_METHOD(New);
 
+  // Pixel access
+  uchar* ExportBits();
+  static void FreeBits(char* data, void* hint);
+
   // Wrapped methods
   static NAN_METHOD(IsNull);
+  static NAN_METHOD(Width);
+  static NAN_METHOD(Height);
+  static NAN_METHOD(Format);
+  static NAN_METHOD(BytesPerLine);
+  static NAN_METHOD(ByteCount);
+  static NAN_METHOD(Bits);
+  static NAN_METHOD(HasAlphaChannel);
+  static NAN_METHOD(ConvertToFormat);
+  static NAN_METHOD(SaveAsync);
+  static NAN_METHOD(Scaled);
+  static NAN_METHOD(ScaledAsync);
+  static NAN_METHOD(Transformed);
+  static NAN_METHOD(TransformedAsync);
 
   // Wrapped object
   QImage* q_;
+
+  // Owner of the pixel memory handed out by bits(); q_ is a view onto it
+  QImage owner_;
+
+  // Buffer whose memory q_ aliases, if constructed from raw pixels
+  Nan::Persistent<v8::Object> source_;
+
+  // Free-callback hint of Buffers returned by bits()
+  struct ExportedBits {
+    QImage image;
+    Nan::Persistent<v8::Object> source;
+  };
 };
@@ -0,0 +1,324 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <node_buffer.h>
+#include <QBuffer>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QHash>
+#include <QQueue>
+#include "../qt_v8.h"
+#include "qimage.h"
+#include "qimageio.h"
+
+using namespace v8;
+
+// Load scheduling state. Each isolate (main thread or Worker) has its own
+// queue, only touched on that isolate's thread.
+struct LoadQueue {
+  LoadQueue() : concurrency(4), running(0), last_id(0) {}
+  // Loads that never started die with their environment
+  ~LoadQueue() { qDeleteAll(pending); }
+
+  int concurrency;
+  int running;
+  int last_id;
+  QQueue<QImageLoadWorker*> pending;
+  QHash<int, QImageLoadWorker*> loads;
+};
+
+static qt_v8::IsolateData<LoadQueue> load_queues;
+
+static void PumpLoads(LoadQueue* queue) {
+  while (queue->running < queue->concurrency && !queue->pending.isEmpty()) {
+    queue->running++;
+    Nan::AsyncQueueWorker(queue->pending.dequeue());
+  }
+}
+
+QImageLoadWorker::QImageLoadWorker(Nan::Callback* callback, int id) 
+    : Nan::AsyncWorker(callback), id_(id), data_(NULL), length_(0), 
+      cancelled_(0) {
+}
+
+void QImageLoadWorker::SetData(const char* data, size_t length) {
+  data_ = data;
+  length_ = length;
+}
+
+void QImageLoadWorker::Execute() {
+  if (IsCancelled()) {
+    SetErrorMessage("QImage.load: cancelled");
+    return;
+  }
+
+  // The Buffer is kept alive in the worker's persistent handle
+  QByteArray bytes;
+  QBuffer buffer;
+  QImageReader reader;
+
+  if (data_) {
+    bytes = QByteArray::fromRawData(data_, static_cast<int>(length_));
+    buffer.setBuffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+    reader.setDevice(&buffer);
+  } else {
+    reader.setFileName(path_);
+  }
+
+  if (!format_.isEmpty())
+    reader.setFormat(format_);
+
+  if (scaled_size_.width() > 0 || scaled_size_.height() > 0) {
+    // Fill in a missing dimension from the aspect ratio in the header
+    QSize size = scaled_size_;
+    QSize full = reader.size();
+
+    if (!full.isEmpty() && size.width() <= 0)
+      size.setWidth(qMax(1, full.width() * size.height() / full.height()));
+    else if (!full.isEmpty() && size.height() <= 0)
+      size.setHeight(qMax(1, full.height() * size.width() / full.width()));
+
+    // Decoders that support it (e.g. JPEG) scale while decoding
+    if (size.isValid())
+      reader.setScaledSize(size);
+  }
+
+  if (!reader.read(&image_)) {
+    SetErrorMessage(qPrintable("QImage.load: " + reader.errorString()));
+    return;
+  }
+}
+
+void QImageLoadWorker::HandleCancelled() {
+  Nan::HandleScope scope;
+
+  Local<Value> argv[] = { Nan::Error("QImage.load: cancelled") };
+  callback->Call(1, argv);
+}
+
+void QImageLoadWorker::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  if (IsCancelled())
+    return HandleCancelled();
+
+  Local<Value> argv[] = { Nan::Null(), QImageWrap::NewInstance(image_) };
+  callback->Call(2, argv);
+}
+
+void QImageLoadWorker::WorkComplete() {
+  LoadQueue* queue = load_queues.Get();
+  queue->loads.remove(id_);
+  queue->running--;
+
+  Nan::AsyncWorker::WorkComplete();
+
+  PumpLoads(queue);
+}
+
+// Supported implementations:
+//   QImage.loadAsync ( QString path | Buffer data, Object options, 
+//       Function callback )
+// Options are format (e.g. 'JPEG') and width/height to decode at a smaller
+// size. Calls back with (err, image); returns an id for cancelLoad().
+NAN_METHOD(QImageIO::Load) {
+  if (!(info[0]->IsString() || node::Buffer::HasInstance(info[0])) ||
+      !info[2]->IsFunction()) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QImage::Load: bad arguments").ToLocalChecked()));
+  }
+
+  LoadQueue* queue = load_queues.Get();
+  int id = ++queue->last_id;
+  QImageLoadWorker* worker = new QImageLoadWorker(
+      new Nan::Callback(info[2].As<Function>()), id);
+
+  if (info[0]->IsString()) {
+    worker->SetFile(qt_v8::ToQString(info[0]->ToString()));
+  } else {
+    worker->SaveToPersistent("source", info[0]);
+    worker->SetData(node::Buffer::Data(info[0]), 
+        node::Buffer::Length(info[0]));
+  }
+
+  if (info[1]->IsObject()) {
+    Local<Object> options = info[1]->ToObject();
+    Local<Value> format = Nan::Get(options, 
+        Nan::New("format").ToLocalChecked()).ToLocalChecked();
+    Local<Value> width = Nan::Get(options, 
+        Nan::New("width").ToLocalChecked()).ToLocalChecked();
+    Local<Value> height = Nan::Get(options, 
+        Nan::New("height").ToLocalChecked()).ToLocalChecked();
+
+    if (format->IsString())
+      worker->SetFormat(qt_v8::ToQString(format->ToString()).toLatin1());
+
+    worker->SetScaledSize(QSize(
+        width->IsNumber() ? width->IntegerValue() : -1, 
+        height->IsNumber() ? height->IntegerValue() : -1));
+  }
+
+  queue->loads.insert(id, worker);
+  queue->pending.enqueue(worker);
+  PumpLoads(queue);
+
+  info.GetReturnValue().Set(Nan::New(id));
+}
+
+// Supported implementations:
+//   QImage.cancelLoad ( int id )
+// A load that hasn't started yet is dropped and calls back right away. One
+// that is decoding finishes in the background and calls back with an error.
+// Returns false if the id is unknown or already completed.
+NAN_METHOD(QImageIO::CancelLoad) {
+  LoadQueue* queue = load_queues.Get();
+  QImageLoadWorker* worker = queue->loads.value(info[0]->Int32Value(), NULL);
+
+  if (!worker || worker->IsCancelled()) {
+    info.GetReturnValue().Set(Nan::False());
+    return;
+  }
+
+  worker->Cancel();
+
+  if (queue->pending.removeOne(worker)) {
+    queue->loads.remove(worker->id());
+    worker->HandleCancelled();
+    delete worker;
+  }
+
+  info.GetReturnValue().Set(Nan::True());
+}
+
+// Supported implementations:
+//   QImage.setLoadConcurrency ( int n )
+NAN_METHOD(QImageIO::SetLoadConcurrency) {
+  if (!info[0]->IsNumber() || info[0]->Int32Value() < 1) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QImage::SetLoadConcurrency: bad argument")
+        .ToLocalChecked()));
+  }
+
+  LoadQueue* queue = load_queues.Get();
+  queue->concurrency = info[0]->Int32Value();
+  PumpLoads(queue);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+QImageSaveWorker::QImageSaveWorker(Nan::Callback* callback, 
+    const QImage& image, const QString& path, const QByteArray& format, 
+    int quality) 
+    : Nan::AsyncWorker(callback), image_(image), path_(path), 
+      format_(format), quality_(quality) {
+}
+
+void QImageSaveWorker::Execute() {
+  QBuffer buffer(&bytes_);
+  QImageWriter writer;
+
+  if (path_.isEmpty()) {
+    buffer.open(QIODevice::WriteOnly);
+    writer.setDevice(&buffer);
+    writer.setFormat(format_.isEmpty() ? QByteArray("PNG") : format_);
+  } else {
+    // Without a format the writer goes by the file suffix
+    writer.setFileName(path_);
+    if (!format_.isEmpty())
+      writer.setFormat(format_);
+  }
+
+  writer.setQuality(quality_);
+
+  if (!writer.write(image_))
+    SetErrorMessage(qPrintable("saveAsync: " + writer.errorString()));
+}
+
+void QImageSaveWorker::FreeBytes(char* data, void* hint) {
+  delete static_cast<QByteArray*>(hint);
+}
+
+void QImageSaveWorker::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  if (!path_.isEmpty()) {
+    Local<Value> argv[] = { Nan::Null() };
+    callback->Call(1, argv);
+    return;
+  }
+
+  // Hand the encoded bytes to the Buffer without copying them
+  QByteArray* bytes = new QByteArray();
+  bytes->swap(bytes_);
+
+  Local<Value> argv[] = { 
+    Nan::Null(), 
+    Nan::NewBuffer(bytes->data(), bytes->size(), FreeBytes, bytes)
+        .ToLocalChecked() 
+  };
+  callback->Call(2, argv);
+}
+
+// Supported implementations:
+//   saveAsync ( QString path | null, QString format | null, int quality, 
+//       Function callback )
+// Calls back with (err) when writing a file, or (err, buffer) when path is
+// null. quality is -1 for the format's default, else 0-100; for PNG it 
+// selects the compression level.
+void QImageIO::Save(Nan::NAN_METHOD_ARGS_TYPE info, const QImage& image) {
+  if (!(info[0]->IsString() || info[0]->IsNull() || 
+      info[0]->IsUndefined()) || !info[3]->IsFunction()) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("saveAsync: bad arguments").ToLocalChecked()));
+  }
+
+  QString path;
+  if (info[0]->IsString())
+    path = qt_v8::ToQString(info[0]->ToString());
+
+  QByteArray format;
+  if (info[1]->IsString())
+    format = qt_v8::ToQString(info[1]->ToString()).toLatin1();
+
+  int quality = info[2]->IsNumber() ? 
+      qBound(-1, static_cast<int>(info[2]->Int32Value()), 100) : -1;
+
+  QImageSaveWorker* worker = new QImageSaveWorker(
+      new Nan::Callback(info[3].As<Function>()), image, path, format, 
+      quality);
+
+  // The image may be a view onto memory owned by the wrapper (see 
+  // QImageWrap::ExportBits), so keep the wrapper alive until we're done
+  worker->SaveToPersistent("owner", info.This());
+
+  Nan::AsyncQueueWorker(worker);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
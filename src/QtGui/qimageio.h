@@ -0,0 +1,105 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <QImage>
+#include <QByteArray>
+#include <QString>
+#include <QSize>
+#include <QAtomicInt>
+
+//
+// QImageIO
+// Image decoding and encoding on the libuv threadpool. QImage and QImageReader don't 
+// touch the GUI, so they are safe to use off the main thread. At most 
+// LoadConcurrency() loads run at once; the rest wait in a FIFO so a large 
+// batch doesn't monopolize the threadpool that fs and crypto share.
+//
+class QImageIO {
+ public:
+  static NAN_METHOD(Load);
+  static NAN_METHOD(CancelLoad);
+  static NAN_METHOD(SetLoadConcurrency);
+
+  // Backs QImage/QPixmap.saveAsync(); image must already be converted
+  static void Save(Nan::NAN_METHOD_ARGS_TYPE info, const QImage& image);
+};
+
+class QImageLoadWorker : public Nan::AsyncWorker {
+ public:
+  QImageLoadWorker(Nan::Callback* callback, int id);
+
+  int id() const { return id_; }
+  void SetFile(const QString& path) { path_ = path; }
+  void SetData(const char* data, size_t length);
+  void SetFormat(const QByteArray& format) { format_ = format; }
+  void SetScaledSize(const QSize& size) { scaled_size_ = size; }
+  void Cancel() { cancelled_.fetchAndStoreOrdered(1); }
+  bool IsCancelled() { return cancelled_.fetchAndAddOrdered(0) != 0; }
+
+  void Execute();
+  void WorkComplete();
+  void HandleCancelled();
+
+ protected:
+  void HandleOKCallback();
+
+ private:
+  int id_;
+  QString path_;
+  const char* data_;
+  size_t length_;
+  QByteArray format_;
+  QSize scaled_size_;
+  QAtomicInt cancelled_;
+  QImage image_;
+};
+
+class QImageSaveWorker : public Nan::AsyncWorker {
+ public:
+  QImageSaveWorker(Nan::Callback* callback, const QImage& image, 
+      const QString& path, const QByteArray& format, int quality);
+
+  void Execute();
+
+ protected:
+  void HandleOKCallback();
+
+ private:
+  static void FreeBytes(char* data, void* hint);
+
+  QImage image_;
+  QString path_;
+  QByteArray format_;
+  int quality_;
+  QByteArray bytes_;
+};
@@ -32,8 +32,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QKeyEventWrap::prototype;
-Nan::Persistent<Function> QKeyEventWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QKeyEventWrap::prototype;
+qt_v8::PerIsolate<Function> QKeyEventWrap::constructor;
 
 QKeyEventWrap::QKeyEventWrap() : q_(NULL) {
   // Standalone constructor not implemented
@@ -48,7 +48,7 @@ NAN_MODULE_INIT(QKeyEventWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QKeyEvent").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   Nan::SetPrototypeMethod(tpl, "key", Key);
   Nan::SetPrototypeMethod(tpl, "text", Text);
@@ -62,12 +62,13 @@ NAN_MODULE_INIT(QKeyEventWrap::Initialize) {
 NAN_METHOD(QKeyEventWrap::New) {
   QKeyEventWrap* w = new QKeyEventWrap;
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QKeyEventWrap::NewInstance(QKeyEvent q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QKeyEventWrap* w = node::ObjectWrap::Unwrap<QKeyEventWrap>(instance);
   w->SetWrapped(q);
 
@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QKeyEvent>
 
 class QKeyEventWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QKeyEvent* GetWrapped() const { return q_; };
   void SetWrapped(QKeyEvent q) { 
@@ -45,7 +46,7 @@ class QKeyEventWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QKeyEvent q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QKeyEventWrap();
   ~QKeyEventWrap();
   static NAN_METHOD(New);
@@ -32,8 +32,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QMatrixWrap::prototype;
-Nan::Persistent<Function> QMatrixWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QMatrixWrap::prototype;
+qt_v8::PerIsolate<Function> QMatrixWrap::constructor;
 
 // Supported implementations:
 //   QMatrix ( )
@@ -47,12 +47,12 @@ QMatrixWrap::QMatrixWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
   } else if (info[0]->IsObject()) {
     // QMatrix ( QMatrix matrix )
 
-    QString arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-
-    if (arg0_constructor != "QMatrix")
+    if (!qt_v8::HasTag(info[0], &QMatrixWrap::prototype)) {
       Nan::ThrowError(Exception::TypeError(
         Nan::New("QMatrix::QMatrix: bad argument").ToLocalChecked()));
+      q_ = new QMatrix();
+      return;
+    }
 
     // Unwrap obj
     QMatrixWrap* q_wrap = ObjectWrap::Unwrap<QMatrixWrap>(
@@ -77,7 +77,7 @@ NAN_MODULE_INIT(QMatrixWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QMatrix").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "m11", M11);
@@ -98,12 +98,13 @@ NAN_MODULE_INIT(QMatrixWrap::Initialize) {
 NAN_METHOD(QMatrixWrap::New) {
   QMatrixWrap* w = new QMatrixWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QMatrixWrap::NewInstance(QMatrix q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QMatrixWrap* w = node::ObjectWrap::Unwrap<QMatrixWrap>(instance);
   w->SetWrapped(q);
 
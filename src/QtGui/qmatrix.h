@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QMatrix>
 
 class QMatrixWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QMatrix* GetWrapped() const { return q_; };
   void SetWrapped(QMatrix q) { 
@@ -45,7 +46,7 @@ class QMatrixWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QMatrix q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QMatrixWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QMatrixWrap();
   static NAN_METHOD(New);
@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qmouseevent.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QMouseEventWrap::prototype;
-Nan::Persistent<Function> QMouseEventWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QMouseEventWrap::prototype;
+qt_v8::PerIsolate<Function> QMouseEventWrap::constructor;
 
 QMouseEventWrap::QMouseEventWrap() : q_(NULL) {
   // Standalone constructor not implemented
@@ -47,7 +48,7 @@ NAN_MODULE_INIT(QMouseEventWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QMouseEvent").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   Nan::SetPrototypeMethod(tpl, "x", X);
   Nan::SetPrototypeMethod(tpl, "y", Y);
@@ -62,12 +63,13 @@ NAN_MODULE_INIT(QMouseEventWrap::Initialize) {
 NAN_METHOD(QMouseEventWrap::New) {
   QMouseEventWrap* w = new QMouseEventWrap();
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QMouseEventWrap::NewInstance(QMouseEvent q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QMouseEventWrap* w = node::ObjectWrap::Unwrap<QMouseEventWrap>(instance);
   w->SetWrapped(q);
 
@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QMouseEvent>
 
 class QMouseEventWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   static v8::Handle<v8::Value> NewInstance(QMouseEvent q);
   QMouseEvent* GetWrapped() const { return q_; };
@@ -45,7 +46,7 @@ class QMouseEventWrap : public node::ObjectWrap {
   };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QMouseEventWrap();
   ~QMouseEventWrap();
   static NAN_METHOD(New);
@@ -27,7 +27,10 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <QFontDatabase>
+#include <QHash>
 #include "../qt_v8.h"
+#include "../qt_parallel.h"
 #include "qpainter.h"
 #include "qpixmap.h"
 #include "qcolor.h"
@@ -37,12 +40,16 @@
 #include "qpainterpath.h"
 #include "qfont.h"
 #include "qmatrix.h"
+#include "qtransform.h"
+#include "qpicture.h"
+#include "qstatictext.h"
+#include "paintcommands.h"
 #include "../QtWidgets/qwidget.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QPainterWrap::prototype;
-Nan::Persistent<Function> QPainterWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPainterWrap::prototype;
+qt_v8::PerIsolate<Function> QPainterWrap::constructor;
 
 QPainterWrap::QPainterWrap() {
   q_ = new QPainter();
@@ -55,7 +62,7 @@ NAN_MODULE_INIT(QPainterWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QPainter").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "begin", Begin);
@@ -66,16 +73,31 @@ NAN_MODULE_INIT(QPainterWrap::Initialize) {
   Nan::SetPrototypeMethod(tpl, "setPen", SetPen);
   Nan::SetPrototypeMethod(tpl, "setFont", SetFont);
   Nan::SetPrototypeMethod(tpl, "setMatrix", SetMatrix);
+  Nan::SetPrototypeMethod(tpl, "setTransform", SetTransform);
+  Nan::SetPrototypeMethod(tpl, "transform", Transform);
   Nan::SetPrototypeMethod(tpl, "fillRect", FillRect);
   Nan::SetPrototypeMethod(tpl, "drawText", DrawText);
+  Nan::SetPrototypeMethod(tpl, "drawStaticText", DrawStaticText);
   Nan::SetPrototypeMethod(tpl, "drawPixmap", DrawPixmap);
   Nan::SetPrototypeMethod(tpl, "drawImage", DrawImage);
+  Nan::SetPrototypeMethod(tpl, "drawPicture", DrawPicture);
   Nan::SetPrototypeMethod(tpl, "strokePath", StrokePath);
+  Nan::SetPrototypeMethod(tpl, "fillPath", FillPath);
+  Nan::SetPrototypeMethod(tpl, "drawPolyline", DrawPolyline);
+  Nan::SetPrototypeMethod(tpl, "drawPolygon", DrawPolygon);
+  Nan::SetPrototypeMethod(tpl, "drawPoints", DrawPoints);
+  Nan::SetPrototypeMethod(tpl, "drawLines", DrawLines);
+  Nan::SetPrototypeMethod(tpl, "fillRects", FillRects);
+  Nan::SetPrototypeMethod(tpl, "drawRects", DrawRects);
+  Nan::SetPrototypeMethod(tpl, "execute", Execute);
 
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
   constructor.Reset(function);
   Nan::Set(target, Nan::New("QPainter").ToLocalChecked(), function);
+
+  // Static methods
+  Nan::SetMethod(function, "renderTiled", RenderTiled);
 }
 
 NAN_METHOD(QPainterWrap::New) {
@@ -86,6 +108,7 @@ NAN_METHOD(QPainterWrap::New) {
 
   QPainterWrap* w = new QPainterWrap();
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QPainterWrap::Begin) {
@@ -96,23 +119,31 @@ NAN_METHOD(QPainterWrap::Begin) {
     return Nan::ThrowError(Exception::TypeError(
         Nan::New("QPainterWrap:Begin: bad arguments").ToLocalChecked()));
 
-  QString constructor_name = 
-    qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  
-  // Determine argument type (from its constructor) so we can unwrap it
-  if (constructor_name == "QPixmap") {
+  // Determine argument type (from its tag) so we can unwrap it
+  QWidget* widget;
+  if (qt_v8::HasTag(info[0], &QPixmapWrap::prototype)) {
     // QPixmap
     QPixmapWrap* pixmap_wrap = ObjectWrap::Unwrap<QPixmapWrap>(
         info[0]->ToObject());
     QPixmap* pixmap = pixmap_wrap->GetWrapped();
 
     info.GetReturnValue().Set(Nan::New(q->begin(pixmap)));
-  } else if (constructor_name == "QWidget") {
-    // QWidget
-    QWidgetWrap* widget_wrap = ObjectWrap::Unwrap<QWidgetWrap>(
+  } else if (qt_v8::HasTag(info[0], &QImageWrap::prototype)) {
+    // QImage
+    QImageWrap* image_wrap = ObjectWrap::Unwrap<QImageWrap>(
+        info[0]->ToObject());
+    QImage* image = image_wrap->GetWrapped();
+
+    info.GetReturnValue().Set(Nan::New(q->begin(image)));
+  } else if (qt_v8::HasTag(info[0], &QPictureWrap::prototype)) {
+    // QPicture: records the painting instead of rasterizing it
+    QPictureWrap* picture_wrap = ObjectWrap::Unwrap<QPictureWrap>(
         info[0]->ToObject());
-    QWidget* widget = widget_wrap->GetWrapped();
+    QPicture* picture = picture_wrap->GetWrapped();
 
+    info.GetReturnValue().Set(Nan::New(q->begin(picture)));
+  } else if ((widget = QWidgetWrapBase::UnwrapWidget(info[0]))) {
+    // QWidget and subclasses
     info.GetReturnValue().Set(Nan::New(q->begin(widget)));
   }
   else {
@@ -159,13 +190,7 @@ NAN_METHOD(QPainterWrap::SetPen) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-
-  if (arg0_constructor != "QPen")
+  if (!qt_v8::HasTag(info[0], &QPenWrap::prototype))
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::SetPen: bad argument").ToLocalChecked()));
 
@@ -183,13 +208,7 @@ NAN_METHOD(QPainterWrap::SetFont) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-
-  if (arg0_constructor != "QFont")
+  if (!qt_v8::HasTag(info[0], &QFontWrap::prototype))
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::SetFont: bad argument").ToLocalChecked()));
 
@@ -208,13 +227,7 @@ NAN_METHOD(QPainterWrap::SetMatrix) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-
-  if (arg0_constructor != "QMatrix")
+  if (!qt_v8::HasTag(info[0], &QMatrixWrap::prototype))
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::SetMatrix: bad argument").ToLocalChecked()));
 
@@ -228,6 +241,34 @@ NAN_METHOD(QPainterWrap::SetMatrix) {
   info.GetReturnValue().Set(Nan::Undefined());
 }
 
+// Supported versions:
+//   setTransform( QTransform transform, bool combine = false )
+NAN_METHOD(QPainterWrap::SetTransform) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[0], &QTransformWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::SetTransform: bad argument").ToLocalChecked()));
+
+  // Unwrap obj
+  QTransformWrap* transform_wrap = ObjectWrap::Unwrap<QTransformWrap>(
+      info[0]->ToObject());
+  QTransform* transform = transform_wrap->GetWrapped();
+
+  q->setTransform(*transform, info[1]->BooleanValue());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Returns a copy of the world transform
+NAN_METHOD(QPainterWrap::Transform) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(QTransformWrap::NewInstance(q->transform()));
+}
+
 // Supported versions:
 //   fillRect(int x, int y, int w, int h, QBrush brush)
 //   fillRect(int x, int y, int w, int h, QColor color)
@@ -240,13 +281,7 @@ NAN_METHOD(QPainterWrap::FillRect) {
       !info[3]->IsNumber())
     info.GetReturnValue().Set(Nan::Undefined());
       
-  QString arg4_constructor;
-  if (info[4]->IsObject()) {
-    arg4_constructor = 
-        qt_v8::ToQString(info[4]->ToObject()->GetConstructorName());
-  }
-  
-  if (arg4_constructor == "QBrush") {
+  if (qt_v8::HasTag(info[4], &QBrushWrap::prototype)) {
     // fillRect(int x, int y, int w, int h, QBrush brush)
 
     // Unwrap QBrush
@@ -257,7 +292,7 @@ NAN_METHOD(QPainterWrap::FillRect) {
     q->fillRect(info[0]->IntegerValue(), info[1]->IntegerValue(),
                 info[2]->IntegerValue(), info[3]->IntegerValue(), 
                 *brush);
-  } else if (arg4_constructor == "QColor") {
+  } else if (qt_v8::HasTag(info[4], &QColorWrap::prototype)) {
     // fillRect(int x, int y, int w, int h, QColor color)
 
     // Unwrap QColor
@@ -291,6 +326,9 @@ NAN_METHOD(QPainterWrap::DrawText) {
   if (!info[0]->IsNumber() || !info[1]->IsNumber() || !info[2]->IsString())
     return Nan::ThrowError(Exception::TypeError(
         Nan::New("QPainterWrap:DrawText: bad arguments").ToLocalChecked()));
+
+  if (!qt_v8::RequireTextThread("QPainter::drawText"))
+    return;
       
   q->drawText(info[0]->IntegerValue(), info[1]->IntegerValue(), 
       qt_v8::ToQString(info[2]->ToString()));
@@ -299,18 +337,45 @@ NAN_METHOD(QPainterWrap::DrawText) {
 }
 
 // Supported versions:
-//   drawPixmap(int x, int y, QPixmap pixmap)
-NAN_METHOD(QPainterWrap::DrawPixmap) {
+//   drawStaticText(int x, int y, QStaticText text)
+// (x, y) is the top-left corner of the text, not the baseline as in 
+// drawText(). A QStaticText created with a font is drawn in that font; 
+// otherwise the painter's font is used.
+NAN_METHOD(QPainterWrap::DrawStaticText) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg2_constructor;
-  if (info[2]->IsObject()) {
-    arg2_constructor = 
-        qt_v8::ToQString(info[2]->ToObject()->GetConstructorName());
+  if (!info[0]->IsNumber() || !info[1]->IsNumber() || 
+      !qt_v8::HasTag(info[2], &QStaticTextWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterWrap:DrawStaticText: bad arguments").ToLocalChecked()));
+
+  if (!qt_v8::RequireTextThread("QPainter::drawStaticText"))
+    return;
+
+  QStaticTextWrap* text_wrap = ObjectWrap::Unwrap<QStaticTextWrap>(
+      info[2]->ToObject());
+  QPoint position(info[0]->IntegerValue(), info[1]->IntegerValue());
+
+  if (text_wrap->HasFont()) {
+    QFont font = q->font();
+    q->setFont(text_wrap->GetFont());
+    q->drawStaticText(position, *text_wrap->GetWrapped());
+    q->setFont(font);
+  } else {
+    q->drawStaticText(position, *text_wrap->GetWrapped());
   }
 
-  if (arg2_constructor != "QPixmap") {
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   drawPixmap(int x, int y, QPixmap pixmap)
+NAN_METHOD(QPainterWrap::DrawPixmap) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[2], &QPixmapWrap::prototype)) {
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::DrawPixmap: pixmap argument not recognized").ToLocalChecked()));
   }
@@ -336,13 +401,7 @@ NAN_METHOD(QPainterWrap::DrawImage) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg2_constructor;
-  if (info[2]->IsObject()) {
-    arg2_constructor = 
-        qt_v8::ToQString(info[2]->ToObject()->GetConstructorName());
-  }
-
-  if (arg2_constructor != "QImage") {
+  if (!qt_v8::HasTag(info[2], &QImageWrap::prototype)) {
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::DrawImage: image argument not recognized").ToLocalChecked()));
   }
@@ -363,29 +422,39 @@ NAN_METHOD(QPainterWrap::DrawImage) {
 }
 
 // Supported versions:
-//   strokePath( QPainterPath path, QPen pen )
-NAN_METHOD(QPainterWrap::StrokePath) {
+//   drawPicture( int x, int y, QPicture picture )
+// Replays a recorded picture natively, without calling back into JS
+NAN_METHOD(QPainterWrap::DrawPicture) {
   QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
   QPainter* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
+  if (!qt_v8::HasTag(info[2], &QPictureWrap::prototype)) {
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::DrawPicture: picture argument not recognized").ToLocalChecked()));
   }
 
-  if (arg0_constructor != "QPainterPath") {
+  // Unwrap QPicture
+  QPictureWrap* picture_wrap = ObjectWrap::Unwrap<QPictureWrap>(
+      info[2]->ToObject());
+  QPicture* picture = picture_wrap->GetWrapped();
+
+  q->drawPicture(info[0]->IntegerValue(), info[1]->IntegerValue(), *picture);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   strokePath( QPainterPath path, QPen pen )
+NAN_METHOD(QPainterWrap::StrokePath) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[0], &QPainterPathWrap::prototype)) {
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::StrokePath: bad arguments").ToLocalChecked()));
   }
   
-  QString arg1_constructor;
-  if (info[1]->IsObject()) {
-    arg1_constructor = 
-        qt_v8::ToQString(info[1]->ToObject()->GetConstructorName());
-  }
-
-  if (arg1_constructor != "QPen") {
+  if (!qt_v8::HasTag(info[1], &QPenWrap::prototype)) {
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterWrap::StrokePath: bad arguments").ToLocalChecked()));
   }
@@ -404,3 +473,499 @@ NAN_METHOD(QPainterWrap::StrokePath) {
 
   info.GetReturnValue().Set(Nan::Undefined());
 }
+
+// Supported versions:
+//   fillPath( QPainterPath path, QBrush brush )
+//   fillPath( QPainterPath path, QColor color )
+//   fillPath( QPainterPath path, Qt::GlobalColor color )
+// Together with QPainterPathStroker.createStroke() this draws a stroke 
+// that was outlined once instead of on every strokePath() call
+NAN_METHOD(QPainterWrap::FillPath) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[0], &QPainterPathWrap::prototype)) {
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::FillPath: bad arguments").ToLocalChecked()));
+  }
+
+  // Unwrap QPainterPath
+  QPainterPathWrap* path_wrap = ObjectWrap::Unwrap<QPainterPathWrap>(
+      info[0]->ToObject());
+  QPainterPath* path = path_wrap->GetWrapped();
+
+  if (qt_v8::HasTag(info[1], &QBrushWrap::prototype)) {
+    QBrushWrap* brush_wrap = ObjectWrap::Unwrap<QBrushWrap>(
+        info[1]->ToObject());
+    q->fillPath(*path, *brush_wrap->GetWrapped());
+  } else if (qt_v8::HasTag(info[1], &QColorWrap::prototype)) {
+    QColorWrap* color_wrap = ObjectWrap::Unwrap<QColorWrap>(
+        info[1]->ToObject());
+    q->fillPath(*path, *color_wrap->GetWrapped());
+  } else if (info[1]->IsNumber()) {
+    q->fillPath(*path, QBrush((Qt::GlobalColor)info[1]->IntegerValue()));
+  } else {
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::FillPath: bad arguments").ToLocalChecked()));
+  }
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Reads a Float64Array of [x0, y0, x1, y1, ...] as points. When qreal is 
+// double (everywhere but some ARM builds) QPointF has the same layout, so 
+// the array's memory is used as is; otherwise it's converted into storage.
+static bool ReadPoints(Local<Value> value, QVector<QPointF>* storage, 
+    const QPointF** points, int* count) {
+  if (!value->IsFloat64Array())
+    return false;
+
+  Nan::TypedArrayContents<double> coords(value);
+  *count = coords.length() / 2;
+
+  if (sizeof(qreal) == sizeof(double) && 
+      sizeof(QPointF) == 2 * sizeof(double)) {
+    *points = reinterpret_cast<const QPointF*>(*coords);
+    return true;
+  }
+
+  storage->resize(*count);
+  for (int i = 0; i < *count; i++)
+    (*storage)[i] = QPointF((*coords)[i * 2], (*coords)[i * 2 + 1]);
+  *points = storage->constData();
+  return true;
+}
+
+// Supported versions:
+//   drawPolyline( Float64Array xy )
+NAN_METHOD(QPainterWrap::DrawPolyline) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  QVector<QPointF> storage;
+  const QPointF* points;
+  int count;
+
+  if (!ReadPoints(info[0], &storage, &points, &count))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::DrawPolyline: bad argument").ToLocalChecked()));
+
+  q->drawPolyline(points, count);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   drawPolygon( Float64Array xy, Qt::FillRule fillRule = Qt::OddEvenFill )
+NAN_METHOD(QPainterWrap::DrawPolygon) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  QVector<QPointF> storage;
+  const QPointF* points;
+  int count;
+
+  if (!ReadPoints(info[0], &storage, &points, &count))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::DrawPolygon: bad argument").ToLocalChecked()));
+
+  Qt::FillRule rule = Qt::OddEvenFill;
+  if (info[1]->IsNumber())
+    rule = info[1]->Int32Value() == Qt::WindingFill ? 
+        Qt::WindingFill : Qt::OddEvenFill;
+
+  q->drawPolygon(points, count, rule);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   drawPoints( Float64Array xy )
+NAN_METHOD(QPainterWrap::DrawPoints) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  QVector<QPointF> storage;
+  const QPointF* points;
+  int count;
+
+  if (!ReadPoints(info[0], &storage, &points, &count))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::DrawPoints: bad argument").ToLocalChecked()));
+
+  q->drawPoints(points, count);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   drawLines( Float64Array xy )
+// Each consecutive pair of points [x1, y1, x2, y2] is one line
+NAN_METHOD(QPainterWrap::DrawLines) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  QVector<QPointF> storage;
+  const QPointF* points;
+  int count;
+
+  if (!ReadPoints(info[0], &storage, &points, &count))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterWrap::DrawLines: bad argument").ToLocalChecked()));
+
+  q->drawLines(points, count / 2);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Groups rects by color, keeping colors in order of first use. Used by 
+// fillRects()/drawRects() so each color costs one QPainter call.
+static void GroupRectsByColor(const int32_t* xywh, int count, 
+    const uint32_t* argb, int colors, QVector<QRgb>* order, 
+    QHash<QRgb, QVector<QRect> >* groups) {
+  for (int i = 0; i < count; i++) {
+    QRgb color = argb[colors == 1 ? 0 : i];
+    QHash<QRgb, QVector<QRect> >::iterator group = groups->find(color);
+
+    if (group == groups->end()) {
+      order->append(color);
+      group = groups->insert(color, QVector<QRect>());
+    }
+
+    group->append(QRect(xywh[i * 4], xywh[i * 4 + 1], xywh[i * 4 + 2], 
+        xywh[i * 4 + 3]));
+  }
+}
+
+// Reads the (Int32Array xywh, Uint32Array argb) pair of fillRects() and 
+// drawRects(). argb holds one 0xAARRGGBB color per rect, or a single color
+// for all of them.
+static bool ReadRects(Local<Value> rects, Local<Value> colors, bool optional,
+    const int32_t** xywh, int* count, const uint32_t** argb, int* ncolors, 
+    QString* error) {
+  if (!rects->IsInt32Array()) {
+    *error = "rects must be an Int32Array of x, y, width, height";
+    return false;
+  }
+
+  Nan::TypedArrayContents<int32_t> r(rects);
+  *xywh = *r;
+  *count = r.length() / 4;
+  *argb = NULL;
+  *ncolors = 0;
+
+  if (optional && (colors->IsUndefined() || colors->IsNull()))
+    return true;
+
+  if (!colors->IsUint32Array()) {
+    *error = "colors must be a Uint32Array of 0xAARRGGBB values";
+    return false;
+  }
+
+  Nan::TypedArrayContents<uint32_t> c(colors);
+  *argb = *c;
+  *ncolors = c.length();
+
+  if (*ncolors != 1 && *ncolors != *count) {
+    *error = "colors must have one entry, or one per rect";
+    return false;
+  }
+
+  return true;
+}
+
+// Supported versions:
+//   fillRects( Int32Array xywh, Uint32Array argb )
+// Same result as a fillRect() per rect, except that rects are painted 
+// grouped by color (colors in order of first use), which only matters 
+// where rects of different colors overlap.
+NAN_METHOD(QPainterWrap::FillRects) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  const int32_t* xywh;
+  const uint32_t* argb;
+  int count, ncolors;
+  QString error;
+
+  if (!ReadRects(info[0], info[1], false, &xywh, &count, &argb, &ncolors, 
+      &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPainterWrap::FillRects: " + error)));
+
+  QVector<QRgb> order;
+  QHash<QRgb, QVector<QRect> > groups;
+  GroupRectsByColor(xywh, count, argb, ncolors, &order, &groups);
+
+  // fillRect() ignores the pen; so does a NoPen drawRects()
+  QPen pen = q->pen();
+  QBrush brush = q->brush();
+  q->setPen(Qt::NoPen);
+
+  for (int i = 0; i < order.size(); i++) {
+    const QVector<QRect>& rects = groups[order[i]];
+    q->setBrush(QColor::fromRgba(order[i]));
+    q->drawRects(rects.constData(), rects.size());
+  }
+
+  q->setPen(pen);
+  q->setBrush(brush);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   drawRects( Int32Array xywh )
+//   drawRects( Int32Array xywh, Uint32Array argb )
+// Draws with the current pen and brush. With colors, each rect is outlined
+// in its color (the pen's other attributes are kept), grouped by color as
+// in fillRects().
+NAN_METHOD(QPainterWrap::DrawRects) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  const int32_t* xywh;
+  const uint32_t* argb;
+  int count, ncolors;
+  QString error;
+
+  if (!ReadRects(info[0], info[1], true, &xywh, &count, &argb, &ncolors, 
+      &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPainterWrap::DrawRects: " + error)));
+
+  if (!argb) {
+    QVector<QRect> rects(count);
+    for (int i = 0; i < count; i++) {
+      rects[i].setRect(xywh[i * 4], xywh[i * 4 + 1], xywh[i * 4 + 2], 
+          xywh[i * 4 + 3]);
+    }
+    q->drawRects(rects.constData(), rects.size());
+
+    info.GetReturnValue().Set(Nan::Undefined());
+    return;
+  }
+
+  QVector<QRgb> order;
+  QHash<QRgb, QVector<QRect> > groups;
+  GroupRectsByColor(xywh, count, argb, ncolors, &order, &groups);
+
+  QPen pen = q->pen();
+  QPen colored = pen;
+
+  for (int i = 0; i < order.size(); i++) {
+    const QVector<QRect>& rects = groups[order[i]];
+    colored.setColor(QColor::fromRgba(order[i]));
+    q->setPen(colored);
+    q->drawRects(rects.constData(), rects.size());
+  }
+
+  q->setPen(pen);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   execute( Float64Array|Int32Array commands, [String] strings, 
+//            [QPixmap|QImage|QPen] resources )
+//
+// Replays a packed command stream natively in one call. See 
+// qt.QPainter.Op in lib/qt.js for the opcodes and their arguments; strings
+// and resources are referenced from the stream by index.
+NAN_METHOD(QPainterWrap::Execute) {
+  QPainterWrap* w = ObjectWrap::Unwrap<QPainterWrap>(info.This());
+  QPainter* q = w->GetWrapped();
+
+  if (!q->isActive())
+    return Nan::ThrowError(Exception::Error(
+        Nan::New("QPainterWrap::Execute: painter is not active").ToLocalChecked()));
+
+  PaintCommands commands;
+  QString error;
+
+  if (!commands.Parse(info[0], info[1], info[2], &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPainterWrap::Execute: " + error)));
+
+  if (commands.DrawsText() && !qt_v8::RequireTextThread("QPainter::execute"))
+    return;
+
+  if (!commands.Replay(q, &error))
+    return Nan::ThrowError(Exception::Error(
+        qt_v8::FromQString("QPainterWrap::Execute: " + error)));
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+//
+// TileJob
+// Replays the same command stream into each tile of a target image. Tiles
+// are QImages aliasing the target's memory, so there is nothing to stitch;
+// drawing outside a tile is clipped to the tile's device rect.
+//
+class TileJob : public qt_parallel::Job {
+ public:
+  TileJob(QImage* target, int tile_size, const PaintCommands* commands, 
+      const QFont* font, Local<Function> on_tile)
+      : target_(target), commands_(commands), font_(font), 
+        on_tile_(on_tile), stopped_(false) {
+    // Detaches here on the main thread, so every tile aliases the same, 
+    // unshared pixels
+    bits_ = target->bits();
+
+    for (int y = 0; y < target->height(); y += tile_size) {
+      for (int x = 0; x < target->width(); x += tile_size) {
+        tiles_.append(QRect(x, y, tile_size, tile_size)
+            .intersected(target->rect()));
+      }
+    }
+  }
+
+  int count() const { return tiles_.size(); }
+  QString error() const { return error_; }
+  bool stopped() const { return stopped_; }
+
+  void Run(int index) {
+    const QRect& r = tiles_[index];
+    int bytes_per_pixel = target_->depth() / 8;
+    uchar* bits = bits_ + r.y() * target_->bytesPerLine() + 
+        r.x() * bytes_per_pixel;
+
+    QImage tile(bits, r.width(), r.height(), target_->bytesPerLine(), 
+        target_->format());
+    QPainter painter(&tile);
+
+    // Map target coordinates onto the tile through the view transform, so
+    // SetMatrix commands (world transform) replay unchanged
+    painter.setViewport(-r.x(), -r.y(), target_->width(), target_->height());
+    painter.setWindow(0, 0, target_->width(), target_->height());
+    if (font_)
+      painter.setFont(*font_);
+
+    QString error;
+    if (!commands_->Replay(&painter, &error)) {
+      QMutexLocker lock(&mutex_);
+      if (error_.isEmpty())
+        error_ = error;
+    }
+  }
+
+  void Done(int index) {
+    if (on_tile_.IsEmpty() || stopped_)
+      return;
+
+    const QRect& r = tiles_[index];
+    Local<Value> argv[] = {
+      Nan::New(r.x()), Nan::New(r.y()), 
+      Nan::New(r.width()), Nan::New(r.height())
+    };
+
+    Nan::TryCatch try_catch;
+    on_tile_->Call(Nan::GetCurrentContext()->Global(), 4, argv);
+
+    // Rethrown once all tiles are done; no more callbacks until then
+    if (try_catch.HasCaught()) {
+      stopped_ = true;
+      exception_.Reset(try_catch.Exception());
+    }
+  }
+
+  Local<Value> exception() { return Nan::New(exception_); }
+
+ private:
+  QImage* target_;
+  uchar* bits_;
+  const PaintCommands* commands_;
+  const QFont* font_;
+  Local<Function> on_tile_;
+  QVector<QRect> tiles_;
+  QMutex mutex_;
+  QString error_;
+  bool stopped_;
+  Nan::Persistent<Value> exception_;
+};
+
+// Supported implementations:
+//   QPainter.renderTiled ( QImage image, commands, strings, resources, 
+//       Object options )
+// Renders a QPainter.execute() command stream into image, split into tiles
+// that are painted in parallel on the global QThreadPool. Blocks until 
+// every tile is done and returns the tile count. Options:
+//   tileSize - edge length in pixels (default 256)
+//   font     - QFont to start each tile with
+//   onTile   - called as onTile(x, y, width, height) on this thread as each
+//              tile completes; it may read the image but not paint into it
+// Streams with DrawText are rendered tile by tile on this thread where the
+// platform lacks threaded font rendering.
+NAN_METHOD(QPainterWrap::RenderTiled) {
+  if (!qt_v8::HasTag(info[0], &QImageWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterWrap::RenderTiled: bad arguments").ToLocalChecked()));
+
+  QImage* image = ObjectWrap::Unwrap<QImageWrap>(
+      info[0]->ToObject())->GetWrapped();
+
+  // Tiles start on 4-pixel boundaries, which keeps their scanlines 32-bit
+  // aligned for any format of 8 bits per pixel or more
+  if (image->isNull() || image->depth() < 8)
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterWrap::RenderTiled: image must be non-null with "
+            "at least 8 bits per pixel").ToLocalChecked()));
+
+  int tile_size = 256;
+  QFont* font = NULL;
+  Local<Function> on_tile;
+
+  if (info[4]->IsObject()) {
+    Local<Object> options = info[4]->ToObject();
+    Local<Value> size = Nan::Get(options, 
+        Nan::New("tileSize").ToLocalChecked()).ToLocalChecked();
+    Local<Value> font_value = Nan::Get(options, 
+        Nan::New("font").ToLocalChecked()).ToLocalChecked();
+    Local<Value> callback = Nan::Get(options, 
+        Nan::New("onTile").ToLocalChecked()).ToLocalChecked();
+
+    if (size->IsNumber())
+      tile_size = qMax(4, (static_cast<int>(size->Int32Value()) + 3) & ~3);
+    if (qt_v8::HasTag(font_value, &QFontWrap::prototype))
+      font = ObjectWrap::Unwrap<QFontWrap>(font_value->ToObject())
+          ->GetWrapped();
+    if (callback->IsFunction())
+      on_tile = callback.As<Function>();
+  }
+
+  PaintCommands commands;
+  QString error;
+
+  if (!commands.Parse(info[1], info[2], info[3], &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPainterWrap::RenderTiled: " + error)));
+
+  commands.ConvertPixmapsToImages();
+
+  // onTile runs while other tiles are still replaying; it may refill or 
+  // detach the typed array
+  commands.CopyOps();
+
+  if (commands.DrawsText() && 
+      !qt_v8::RequireTextThread("QPainter::renderTiled"))
+    return;
+
+  TileJob job(image, tile_size, &commands, font, on_tile);
+
+  // Without threaded font rendering text may only be drawn on this thread
+  if (commands.DrawsText() && 
+      !QFontDatabase::supportsThreadedFontRendering())
+    qt_parallel::RunHere(&job, job.count());
+  else
+    qt_parallel::Run(&job, job.count());
+
+  if (job.stopped())
+    return Nan::ThrowError(job.exception());
+
+  if (!job.error().isEmpty())
+    return Nan::ThrowError(Exception::Error(
+        qt_v8::FromQString("QPainterWrap::RenderTiled: " + job.error())));
+
+  info.GetReturnValue().Set(Nan::New(job.count()));
+}
@@ -31,16 +31,17 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPainter>
 
 class QPainterWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPainter* GetWrapped() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QPainterWrap();
   ~QPainterWrap();
   static NAN_METHOD(New);
@@ -59,13 +60,28 @@ class QPainterWrap : public node::ObjectWrap {
   static NAN_METHOD(SetPen);
   static NAN_METHOD(SetFont);
   static NAN_METHOD(SetMatrix);
+  static NAN_METHOD(SetTransform);
+  static NAN_METHOD(Transform);
 
   // Paint actions
   static NAN_METHOD(FillRect);
   static NAN_METHOD(DrawText);
+  static NAN_METHOD(DrawStaticText);
   static NAN_METHOD(DrawPixmap);
   static NAN_METHOD(DrawImage);
+  static NAN_METHOD(DrawPicture);
   static NAN_METHOD(StrokePath);
+  static NAN_METHOD(FillPath);
+  static NAN_METHOD(DrawPolyline);
+  static NAN_METHOD(DrawPolygon);
+  static NAN_METHOD(DrawPoints);
+  static NAN_METHOD(DrawLines);
+
+  // Batched paint actions
+  static NAN_METHOD(FillRects);
+  static NAN_METHOD(DrawRects);
+  static NAN_METHOD(Execute);
+  static NAN_METHOD(RenderTiled);
 
   // Wrapped object
   QPainter* q_;
@@ -29,12 +29,13 @@
 
 #include "../QtCore/qpointf.h"
 #include "qpainterpath.h"
+#include "svgpath.h"
 #include "../qt_v8.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QPainterPathWrap::prototype;
-Nan::Persistent<Function> QPainterPathWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPainterPathWrap::prototype;
+qt_v8::PerIsolate<Function> QPainterPathWrap::constructor;
 
 // Supported implementations:
 //   QPainterPath ( ??? )
@@ -50,23 +51,41 @@ NAN_MODULE_INIT(QPainterPathWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QPainterPath").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "moveTo", MoveTo);
   Nan::SetPrototypeMethod(tpl, "lineTo", LineTo);
   Nan::SetPrototypeMethod(tpl, "currentPosition", CurrentPosition);
   Nan::SetPrototypeMethod(tpl, "closeSubpath", CloseSubpath);
+  Nan::SetPrototypeMethod(tpl, "elementCount", ElementCount);
+  Nan::SetPrototypeMethod(tpl, "boundingRect", BoundingRect);
+  Nan::SetPrototypeMethod(tpl, "simplified", Simplified);
 
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
   constructor.Reset(function);
   Nan::Set(target, Nan::New("QPainterPath").ToLocalChecked(), function);
+
+  // Static constructors
+  Nan::SetMethod(function, "fromArrays", FromArrays);
+  Nan::SetMethod(function, "fromSvg", FromSvg);
 }
 
 NAN_METHOD(QPainterPathWrap::New) {
   QPainterPathWrap* w = new QPainterPathWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+Handle<Value> QPainterPathWrap::NewInstance(QPainterPath q) {
+  Nan::EscapableHandleScope scope;
+  
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
+  QPainterPathWrap* w = node::ObjectWrap::Unwrap<QPainterPathWrap>(instance);
+  w->SetWrapped(q);
+
+  return scope.Escape(instance);
 }
 
 // Supported versions:
@@ -75,13 +94,7 @@ NAN_METHOD(QPainterPathWrap::MoveTo) {
   QPainterPathWrap* w = ObjectWrap::Unwrap<QPainterPathWrap>(info.This());
   QPainterPath* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-  
-  if (arg0_constructor != "QPointF")
+  if (!qt_v8::HasTag(info[0], &QPointFWrap::prototype))
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterPathWrap::MoveTo: argument not recognized").ToLocalChecked()));
 
@@ -108,13 +121,7 @@ NAN_METHOD(QPainterPathWrap::LineTo) {
   QPainterPathWrap* w = ObjectWrap::Unwrap<QPainterPathWrap>(info.This());
   QPainterPath* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-  
-  if (arg0_constructor != "QPointF")
+  if (!qt_v8::HasTag(info[0], &QPointFWrap::prototype))
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QPainterPathWrap::MoveTo: argument not recognized").ToLocalChecked()));
 
@@ -136,3 +143,119 @@ NAN_METHOD(QPainterPathWrap::CloseSubpath) {
   
   info.GetReturnValue().Set(Nan::Undefined());
 }
+
+// Number of elements; each curve counts as three (see QPainterPath docs)
+NAN_METHOD(QPainterPathWrap::ElementCount) {
+  QPainterPathWrap* w = ObjectWrap::Unwrap<QPainterPathWrap>(info.This());
+  QPainterPath* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->elementCount()));
+}
+
+// Returns { x, y, width, height }, for culling paths before drawing them
+NAN_METHOD(QPainterPathWrap::BoundingRect) {
+  QPainterPathWrap* w = ObjectWrap::Unwrap<QPainterPathWrap>(info.This());
+  QPainterPath* q = w->GetWrapped();
+
+  QRectF rect = q->boundingRect();
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New(rect.x()));
+  Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New(rect.y()));
+  Nan::Set(result, Nan::New("width").ToLocalChecked(), 
+      Nan::New(rect.width()));
+  Nan::Set(result, Nan::New("height").ToLocalChecked(), 
+      Nan::New(rect.height()));
+
+  info.GetReturnValue().Set(result);
+}
+
+// Returns a new path with overlapping subpaths merged and no 
+// self-intersections
+NAN_METHOD(QPainterPathWrap::Simplified) {
+  QPainterPathWrap* w = ObjectWrap::Unwrap<QPainterPathWrap>(info.This());
+  QPainterPath* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(NewInstance(q->simplified()));
+}
+
+// Verbs of fromArrays(), exported as qt.QPainterPath.Verb
+enum Verb { MoveTo = 0, LineTo = 1, QuadTo = 2, CubicTo = 3, Close = 4 };
+
+// Number of coordinates each verb consumes
+static const int kVerbCoords[] = { 2, 2, 4, 6, 0 };
+
+// Supported versions:
+//   QPainterPath.fromArrays( Uint8Array verbs, Float64Array coords )
+// Builds a whole path in one call. coords holds the x, y pairs for the 
+// verbs in order: 1 pair for MoveTo/LineTo, 2 for QuadTo, 3 for CubicTo 
+// and none for Close.
+NAN_METHOD(QPainterPathWrap::FromArrays) {
+  if (!info[0]->IsUint8Array() || !info[1]->IsFloat64Array())
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterPathWrap::FromArrays: bad arguments").ToLocalChecked()));
+
+  Nan::TypedArrayContents<uint8_t> verbs(info[0]);
+  Nan::TypedArrayContents<double> coords(info[1]);
+  const double* c = *coords;
+  size_t used = 0;
+
+  QPainterPath path;
+
+  for (size_t i = 0; i < verbs.length(); i++) {
+    int verb = (*verbs)[i];
+
+    if (verb > Close) {
+      return Nan::ThrowError(Exception::TypeError(qt_v8::FromQString(
+          QString("QPainterPathWrap::FromArrays: unknown verb %1 at index %2")
+          .arg(verb).arg(i))));
+    }
+
+    if (used + kVerbCoords[verb] > coords.length()) {
+      return Nan::ThrowError(Exception::TypeError(qt_v8::FromQString(
+          QString("QPainterPathWrap::FromArrays: coords end at verb %1")
+          .arg(i))));
+    }
+
+    const double* p = c + used;
+    switch (verb) {
+      case MoveTo:
+        path.moveTo(p[0], p[1]);
+        break;
+      case LineTo:
+        path.lineTo(p[0], p[1]);
+        break;
+      case QuadTo:
+        path.quadTo(p[0], p[1], p[2], p[3]);
+        break;
+      case CubicTo:
+        path.cubicTo(p[0], p[1], p[2], p[3], p[4], p[5]);
+        break;
+      case Close:
+        path.closeSubpath();
+        break;
+    }
+
+    used += kVerbCoords[verb];
+  }
+
+  info.GetReturnValue().Set(NewInstance(path));
+}
+
+// Supported versions:
+//   QPainterPath.fromSvg( QString d )
+// Parses SVG path data, e.g. "M10 10 h80 a10 10 0 0 1 -10 10 z"
+NAN_METHOD(QPainterPathWrap::FromSvg) {
+  if (!info[0]->IsString())
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QPainterPathWrap::FromSvg: bad argument").ToLocalChecked()));
+
+  QPainterPath path;
+  QString error;
+
+  if (!svgpath::Parse(qt_v8::ToQString(info[0]->ToString()), &path, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPainterPathWrap::FromSvg: " + error)));
+
+  info.GetReturnValue().Set(NewInstance(path));
+}
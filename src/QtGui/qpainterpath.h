@@ -31,16 +31,22 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPainterPath>
 
 class QPainterPathWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPainterPath* GetWrapped() const { return q_; };
+  void SetWrapped(QPainterPath q) { 
+    if (q_) delete q_; 
+    q_ = new QPainterPath(q); 
+  };
+  static v8::Handle<v8::Value> NewInstance(QPainterPath q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QPainterPathWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QPainterPathWrap();
   static NAN_METHOD(New);
@@ -50,6 +56,13 @@ class QPainterPathWrap : public node::ObjectWrap {
   static NAN_METHOD(CurrentPosition);
   static NAN_METHOD(LineTo);
   static NAN_METHOD(CloseSubpath);
+  static NAN_METHOD(ElementCount);
+  static NAN_METHOD(BoundingRect);
+  static NAN_METHOD(Simplified);
+
+  // Static constructors
+  static NAN_METHOD(FromArrays);
+  static NAN_METHOD(FromSvg);
 
   // Wrapped object
   QPainterPath* q_;
@@ -0,0 +1,292 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "../qt_v8.h"
+#include "qpainterpathstroker.h"
+#include "qpainterpath.h"
+#include "qpen.h"
+
+using namespace v8;
+
+qt_v8::PerIsolate<FunctionTemplate> QPainterPathStrokerWrap::prototype;
+qt_v8::PerIsolate<Function> QPainterPathStrokerWrap::constructor;
+
+// Supported implementations:
+//   QPainterPathStroker ( )
+//   QPainterPathStroker ( QPen pen )
+QPainterPathStrokerWrap::QPainterPathStrokerWrap(
+    Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
+  q_ = new QPainterPathStroker();
+
+  if (!qt_v8::HasTag(info[0], &QPenWrap::prototype))
+    return;
+
+  // Take width, caps, joins and dashes from the pen, as 
+  // QPainterPathStroker(QPen) does on Qt 5.3+
+  QPen* pen = ObjectWrap::Unwrap<QPenWrap>(info[0]->ToObject())->GetWrapped();
+
+  // A cosmetic (zero width) pen strokes one unit wide
+  q_->setWidth(pen->widthF() == 0 ? 1 : pen->widthF());
+  q_->setCapStyle(pen->capStyle());
+  q_->setJoinStyle(pen->joinStyle());
+  q_->setMiterLimit(pen->miterLimit());
+  q_->setDashOffset(pen->dashOffset());
+
+  if (pen->style() == Qt::CustomDashLine)
+    q_->setDashPattern(pen->dashPattern());
+  else
+    q_->setDashPattern(pen->style());
+}
+
+QPainterPathStrokerWrap::~QPainterPathStrokerWrap() {
+  delete q_;
+}
+
+NAN_MODULE_INIT(QPainterPathStrokerWrap::Initialize) {
+  // Prepare constructor template
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("QPainterPathStroker").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
+
+  // Prototype
+  Nan::SetPrototypeMethod(tpl, "width", Width);
+  Nan::SetPrototypeMethod(tpl, "setWidth", SetWidth);
+  Nan::SetPrototypeMethod(tpl, "capStyle", CapStyle);
+  Nan::SetPrototypeMethod(tpl, "setCapStyle", SetCapStyle);
+  Nan::SetPrototypeMethod(tpl, "joinStyle", JoinStyle);
+  Nan::SetPrototypeMethod(tpl, "setJoinStyle", SetJoinStyle);
+  Nan::SetPrototypeMethod(tpl, "miterLimit", MiterLimit);
+  Nan::SetPrototypeMethod(tpl, "setMiterLimit", SetMiterLimit);
+  Nan::SetPrototypeMethod(tpl, "curveThreshold", CurveThreshold);
+  Nan::SetPrototypeMethod(tpl, "setCurveThreshold", SetCurveThreshold);
+  Nan::SetPrototypeMethod(tpl, "dashOffset", DashOffset);
+  Nan::SetPrototypeMethod(tpl, "setDashOffset", SetDashOffset);
+  Nan::SetPrototypeMethod(tpl, "setDashPattern", SetDashPattern);
+  Nan::SetPrototypeMethod(tpl, "createStroke", CreateStroke);
+
+  prototype.Reset(tpl);
+  Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
+  constructor.Reset(function);
+  Nan::Set(target, Nan::New("QPainterPathStroker").ToLocalChecked(), 
+      function);
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::New) {
+  QPainterPathStrokerWrap* w = new QPainterPathStrokerWrap(info);
+  w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::Width) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->width()));
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::SetWidth) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetWidth: bad argument").ToLocalChecked()));
+
+  q->setWidth(info[0]->NumberValue());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::CapStyle) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New((int)q->capStyle()));
+}
+
+// Supported versions:
+//   setCapStyle( Qt::PenCapStyle style )
+NAN_METHOD(QPainterPathStrokerWrap::SetCapStyle) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetCapStyle: bad argument").ToLocalChecked()));
+
+  q->setCapStyle((Qt::PenCapStyle)info[0]->Int32Value());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::JoinStyle) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New((int)q->joinStyle()));
+}
+
+// Supported versions:
+//   setJoinStyle( Qt::PenJoinStyle style )
+NAN_METHOD(QPainterPathStrokerWrap::SetJoinStyle) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetJoinStyle: bad argument").ToLocalChecked()));
+
+  q->setJoinStyle((Qt::PenJoinStyle)info[0]->Int32Value());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::MiterLimit) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->miterLimit()));
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::SetMiterLimit) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetMiterLimit: bad argument").ToLocalChecked()));
+
+  q->setMiterLimit(info[0]->NumberValue());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::CurveThreshold) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->curveThreshold()));
+}
+
+// Smaller thresholds flatten curves into more line segments
+NAN_METHOD(QPainterPathStrokerWrap::SetCurveThreshold) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetCurveThreshold: bad argument").ToLocalChecked()));
+
+  q->setCurveThreshold(info[0]->NumberValue());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::DashOffset) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->dashOffset()));
+}
+
+NAN_METHOD(QPainterPathStrokerWrap::SetDashOffset) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetDashOffset: bad argument").ToLocalChecked()));
+
+  q->setDashOffset(info[0]->NumberValue());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   setDashPattern( Qt::PenStyle style )
+//   setDashPattern( [dash, space, ...] )
+// Dash and space lengths are in units of the stroke width
+NAN_METHOD(QPainterPathStrokerWrap::SetDashPattern) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (info[0]->IsNumber()) {
+    // setDashPattern( Qt::PenStyle style )
+
+    q->setDashPattern((Qt::PenStyle)info[0]->Int32Value());
+  } else if (info[0]->IsArray()) {
+    // setDashPattern( [dash, space, ...] )
+
+    Local<Array> array = Local<Array>::Cast(info[0]);
+    QVector<qreal> pattern(array->Length());
+
+    for (uint32_t i = 0; i < array->Length(); i++)
+      pattern[i] = Nan::Get(array, i).ToLocalChecked()->NumberValue();
+
+    q->setDashPattern(pattern);
+  } else {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::SetDashPattern: bad argument").ToLocalChecked()));
+  }
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Supported versions:
+//   createStroke( QPainterPath path )
+// Returns the outline of the stroke as a path to be filled, so a static 
+// shape is stroked once and then drawn with painter.fillPath()
+NAN_METHOD(QPainterPathStrokerWrap::CreateStroke) {
+  QPainterPathStrokerWrap* w = 
+      ObjectWrap::Unwrap<QPainterPathStrokerWrap>(info.This());
+  QPainterPathStroker* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[0], &QPainterPathWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPainterPathStroker::CreateStroke: bad argument").ToLocalChecked()));
+
+  QPainterPath* path = ObjectWrap::Unwrap<QPainterPathWrap>(
+      info[0]->ToObject())->GetWrapped();
+
+  info.GetReturnValue().Set(
+      QPainterPathWrap::NewInstance(q->createStroke(*path)));
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include "../qt_v8.h"
+#include <QPainterPathStroker>
+
+class QPainterPathStrokerWrap : public node::ObjectWrap {
+ public:
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
+  static NAN_MODULE_INIT(Initialize);
+  QPainterPathStroker* GetWrapped() const { return q_; };
+
+ private:
+  static qt_v8::PerIsolate<v8::Function> constructor;
+  QPainterPathStrokerWrap(Nan::NAN_METHOD_ARGS_TYPE info);
+  ~QPainterPathStrokerWrap();
+  static NAN_METHOD(New);
+
+  // Wrapped methods
+  static NAN_METHOD(Width);
+  static NAN_METHOD(SetWidth);
+  static NAN_METHOD(CapStyle);
+  static NAN_METHOD(SetCapStyle);
+  static NAN_METHOD(JoinStyle);
+  static NAN_METHOD(SetJoinStyle);
+  static NAN_METHOD(MiterLimit);
+  static NAN_METHOD(SetMiterLimit);
+  static NAN_METHOD(CurveThreshold);
+  static NAN_METHOD(SetCurveThreshold);
+  static NAN_METHOD(DashOffset);
+  static NAN_METHOD(SetDashOffset);
+  static NAN_METHOD(SetDashPattern);
+  static NAN_METHOD(CreateStroke);
+
+  // Wrapped object
+  QPainterPathStroker* q_;
+};
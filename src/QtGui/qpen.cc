@@ -34,20 +34,14 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QPenWrap::prototype;
-Nan::Persistent<Function> QPenWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPenWrap::prototype;
+qt_v8::PerIsolate<Function> QPenWrap::constructor;
 
 // Supported implementations:
 //   QPen (QBrush brush, qreal width, Qt::PenStyle style = Qt::SolidLine, Qt::PenCapStyle cap = Qt::SquareCap, Qt::PenJoinStyle join = Qt::BevelJoin )
 //   QPen (QColor color)
 //   QPen ()
 QPenWrap::QPenWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
-
   if (!info[0]->IsObject()) {
     // QPen ()
   
@@ -55,7 +49,7 @@ QPenWrap::QPenWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
     return;
   }
 
-  if (arg0_constructor == "QColor") {
+  if (qt_v8::HasTag(info[0], &QColorWrap::prototype)) {
     // QPen (QColor color)
 
     // Unwrap QColor
@@ -65,7 +59,7 @@ QPenWrap::QPenWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
 
     q_ = new QPen(*color);
     return;
-  } else if (arg0_constructor == "QBrush") {    
+  } else if (qt_v8::HasTag(info[0], &QBrushWrap::prototype)) {    
     // QPen (QBrush brush, qreal width, Qt::PenStyle style = Qt::SolidLine, Qt::PenCapStyle cap = Qt::SquareCap, Qt::PenJoinStyle join = Qt::BevelJoin )
     
     // Unwrap QBrush
@@ -114,7 +108,7 @@ NAN_MODULE_INIT(QPenWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QPen").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
@@ -125,4 +119,5 @@ NAN_MODULE_INIT(QPenWrap::Initialize) {
 NAN_METHOD(QPenWrap::New) {
   QPenWrap* w = new QPenWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
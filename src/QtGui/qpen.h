@@ -31,16 +31,17 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPen>
 
 class QPenWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPen* GetWrapped() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QPenWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QPenWrap();
   static NAN_METHOD(New);
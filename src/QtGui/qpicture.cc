@@ -0,0 +1,118 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <node_buffer.h>
+#include "../qt_v8.h"
+#include "qpicture.h"
+
+using namespace v8;
+
+qt_v8::PerIsolate<FunctionTemplate> QPictureWrap::prototype;
+qt_v8::PerIsolate<Function> QPictureWrap::constructor;
+
+// Supported implementations:
+//   QPicture ( )
+//   QPicture ( Buffer data )
+QPictureWrap::QPictureWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
+  q_ = new QPicture();
+
+  if (node::Buffer::HasInstance(info[0])) {
+    // QPicture ( Buffer data )
+    q_->setData(node::Buffer::Data(info[0]), node::Buffer::Length(info[0]));
+  }
+}
+
+QPictureWrap::~QPictureWrap() {
+  delete q_;
+}
+
+NAN_MODULE_INIT(QPictureWrap::Initialize) {
+  // Prepare constructor template
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("QPicture").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
+
+  // Prototype
+  Nan::SetPrototypeMethod(tpl, "isNull", IsNull);
+  Nan::SetPrototypeMethod(tpl, "size", Size);
+  Nan::SetPrototypeMethod(tpl, "data", Data);
+  Nan::SetPrototypeMethod(tpl, "setData", SetData);
+
+  prototype.Reset(tpl);
+  Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
+  constructor.Reset(function);
+  Nan::Set(target, Nan::New("QPicture").ToLocalChecked(), function);
+}
+
+NAN_METHOD(QPictureWrap::New) {
+  QPictureWrap* w = new QPictureWrap(info);
+  w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+NAN_METHOD(QPictureWrap::IsNull) {
+  QPictureWrap* w = ObjectWrap::Unwrap<QPictureWrap>(info.This());
+  QPicture* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->isNull()));
+}
+
+// Size of the serialized picture in bytes
+NAN_METHOD(QPictureWrap::Size) {
+  QPictureWrap* w = ObjectWrap::Unwrap<QPictureWrap>(info.This());
+  QPicture* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->size()));
+}
+
+// Returns the serialized picture as a new Buffer, e.g. for caching a 
+// display list on disk. Only valid once the recording painter has ended.
+NAN_METHOD(QPictureWrap::Data) {
+  QPictureWrap* w = ObjectWrap::Unwrap<QPictureWrap>(info.This());
+  QPicture* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(
+      Nan::CopyBuffer(q->data(), q->size()).ToLocalChecked());
+}
+
+// Supported implementations:
+//   setData ( Buffer data )
+NAN_METHOD(QPictureWrap::SetData) {
+  QPictureWrap* w = ObjectWrap::Unwrap<QPictureWrap>(info.This());
+  QPicture* q = w->GetWrapped();
+
+  if (!node::Buffer::HasInstance(info[0])) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPicture::SetData: bad argument").ToLocalChecked()));
+  }
+
+  q->setData(node::Buffer::Data(info[0]), node::Buffer::Length(info[0]));
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
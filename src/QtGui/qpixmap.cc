@@ -27,17 +27,67 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <node_buffer.h>
 #include "../qt_v8.h"
 #include "qpixmap.h"
 #include "qcolor.h"
+#include "qimage.h"
+#include "qimageio.h"
+#include "imagescale.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QPixmapWrap::prototype;
-Nan::Persistent<Function> QPixmapWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPixmapWrap::prototype;
+qt_v8::PerIsolate<Function> QPixmapWrap::constructor;
 
-QPixmapWrap::QPixmapWrap(int width, int height) : q_(NULL) {
-  q_ = new QPixmap(width, height);
+// Supported implementations:
+//   QPixmap ( int width, int height )
+//   QPixmap ( Buffer data, QString format = null )
+//   QPixmap ( Buffer pixels, int width, int height, int bytesPerLine, 
+//       QImage::Format format )
+QPixmapWrap::QPixmapWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
+  if (node::Buffer::HasInstance(info[0]) && info.Length() >= 5) {
+    // QPixmap ( Buffer pixels, int width, int height, int bytesPerLine, 
+    //   QImage::Format format )
+    QString error;
+    QImage image = QImageWrap::FromPixels(info[0], info[1]->IntegerValue(), 
+        info[2]->IntegerValue(), info[3]->IntegerValue(), 
+        info[4]->IntegerValue(), &error);
+
+    if (!error.isEmpty()) {
+      Nan::ThrowError(Exception::TypeError(
+          qt_v8::FromQString("QPixmap::QPixmap: " + error)));
+      q_ = new QPixmap();
+      return;
+    }
+
+    // image may alias the Buffer, and a pixmap in the native format may 
+    // share it, so the pixmap gets its own copy
+    if (image.constBits() == 
+        reinterpret_cast<const uchar*>(node::Buffer::Data(info[0])))
+      image = image.copy();
+
+    q_ = new QPixmap(QPixmap::fromImage(image));
+    return;
+  }
+
+  if (node::Buffer::HasInstance(info[0])) {
+    // QPixmap ( Buffer data, QString format = null )
+    q_ = new QPixmap();
+
+    QByteArray format;
+    if (info[1]->IsString())
+      format = qt_v8::ToQString(info[1]->ToString()).toLatin1();
+
+    q_->loadFromData(
+        reinterpret_cast<const uchar*>(node::Buffer::Data(info[0])),
+        node::Buffer::Length(info[0]), 
+        format.isEmpty() ? NULL : format.constData());
+    return;
+  }
+
+  // QPixmap ( int width, int height )
+  q_ = new QPixmap(info[0]->IntegerValue(), info[1]->IntegerValue());
 }
 QPixmapWrap::~QPixmapWrap() {
   delete q_;
@@ -47,30 +97,42 @@ NAN_MODULE_INIT(QPixmapWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QPixmap").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "width", Width);
   Nan::SetPrototypeMethod(tpl, "height", Height);
   Nan::SetPrototypeMethod(tpl, "save", Save);
+  Nan::SetPrototypeMethod(tpl, "saveAsync", SaveAsync);
   Nan::SetPrototypeMethod(tpl, "fill", Fill);
+  Nan::SetPrototypeMethod(tpl, "depth", Depth);
+  Nan::SetPrototypeMethod(tpl, "hasAlphaChannel", HasAlphaChannel);
+  Nan::SetPrototypeMethod(tpl, "toImage", ToImage);
+  Nan::SetPrototypeMethod(tpl, "scaled", Scaled);
+  Nan::SetPrototypeMethod(tpl, "transformed", Transformed);
 
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
   constructor.Reset(function);
   Nan::Set(target, Nan::New("QPixmap").ToLocalChecked(), function);
+
+  // Static constructors
+  Nan::SetMethod(function, "fromImage", FromImage);
 }
 
 NAN_METHOD(QPixmapWrap::New) {
-  QPixmapWrap* w = new QPixmapWrap(info[0]->IntegerValue(), 
-      info[1]->IntegerValue());
+  if (!qt_v8::RequireGuiThread("QPixmap"))
+    return;
+
+  QPixmapWrap* w = new QPixmapWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QPixmapWrap::NewInstance(QPixmap q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QPixmapWrap* w = node::ObjectWrap::Unwrap<QPixmapWrap>(instance);
   w->SetWrapped(q);
 
@@ -100,6 +162,15 @@ NAN_METHOD(QPixmapWrap::Save) {
   info.GetReturnValue().Set(Nan::New(q->save(file)));
 }
 
+// Converts to a QImage here on the GUI thread, then encodes on the 
+// threadpool; see QImageIO::Save
+NAN_METHOD(QPixmapWrap::SaveAsync) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  QImageIO::Save(info, q->toImage());
+}
+
 // Supports:
 //    fill()
 //    fill(QColor color)
@@ -107,7 +178,7 @@ NAN_METHOD(QPixmapWrap::Fill) {
   QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
   QPixmap* q = w->GetWrapped();
 
-  if (info[0]->IsObject()) {
+  if (qt_v8::HasTag(info[0], &QColorWrap::prototype)) {
     // Unwrap QColor
     QColorWrap* color_wrap = ObjectWrap::Unwrap<QColorWrap>(
         info[0]->ToObject());
@@ -120,3 +191,86 @@ NAN_METHOD(QPixmapWrap::Fill) {
 
   info.GetReturnValue().Set(Nan::Undefined());
 }
+
+// Supported versions:
+//   scaled( int width, int height, Object options = {} )
+// See QImage.scaled(); resamples a QImage copy in parallel
+NAN_METHOD(QPixmapWrap::Scaled) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  QSize size;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadScaleArguments(info, q->size(), &size, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPixmap::Scaled: " + error)));
+
+  QImage scaled = imagescale::Scaled(q->toImage(), size, mode);
+
+  info.GetReturnValue().Set(NewInstance(QPixmap::fromImage(scaled)));
+}
+
+// Supported versions:
+//   transformed( QTransform|QMatrix transform, Object options = {} )
+// See QImage.transformed()
+NAN_METHOD(QPixmapWrap::Transformed) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  QTransform transform;
+  imagescale::Mode mode;
+  QString error;
+  if (!imagescale::ReadTransformArguments(info, &transform, &mode, &error))
+    return Nan::ThrowError(Exception::TypeError(
+        qt_v8::FromQString("QPixmap::Transformed: " + error)));
+
+  QImage transformed = imagescale::Transformed(q->toImage(), transform, 
+      mode);
+
+  info.GetReturnValue().Set(NewInstance(QPixmap::fromImage(transformed)));
+}
+
+NAN_METHOD(QPixmapWrap::Depth) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->depth()));
+}
+
+NAN_METHOD(QPixmapWrap::HasAlphaChannel) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->hasAlphaChannel()));
+}
+
+// Returns a new QImage in the pixmap's native format
+NAN_METHOD(QPixmapWrap::ToImage) {
+  QPixmapWrap* w = ObjectWrap::Unwrap<QPixmapWrap>(info.This());
+  QPixmap* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(QImageWrap::NewInstance(q->toImage()));
+}
+
+// Supported versions:
+//   QPixmap.fromImage( QImage image )
+// Converts once to the native format, so drawPixmap() of the result 
+// doesn't convert on every call
+NAN_METHOD(QPixmapWrap::FromImage) {
+  if (!qt_v8::RequireGuiThread("QPixmap"))
+    return;
+
+  if (!qt_v8::HasTag(info[0], &QImageWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPixmap::FromImage: bad argument").ToLocalChecked()));
+
+  QImageWrap* image_wrap = ObjectWrap::Unwrap<QImageWrap>(
+      info[0]->ToObject());
+  QImage* image = image_wrap->GetWrapped();
+
+  // The pixmap may share an image already in the native format, so a view
+  // is copied first
+  info.GetReturnValue().Set(NewInstance(QPixmap::fromImage(
+      image_wrap->IsView() ? image->copy() : *image)));
+}
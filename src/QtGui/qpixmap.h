@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPixmap>
 
 class QPixmapWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPixmap* GetWrapped() const { return q_; };
   void SetWrapped(QPixmap q) { 
@@ -45,8 +46,8 @@ class QPixmapWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QPixmap q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
-  QPixmapWrap(int width, int height);
+  static qt_v8::PerIsolate<v8::Function> constructor;
+  QPixmapWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QPixmapWrap();
   static NAN_METHOD(New);
 
@@ -54,7 +55,16 @@ class QPixmapWrap : public node::ObjectWrap {
   static NAN_METHOD(Width);
   static NAN_METHOD(Height);
   static NAN_METHOD(Save);
+  static NAN_METHOD(SaveAsync);
   static NAN_METHOD(Fill);
+  static NAN_METHOD(Depth);
+  static NAN_METHOD(HasAlphaChannel);
+  static NAN_METHOD(ToImage);
+  static NAN_METHOD(Scaled);
+  static NAN_METHOD(Transformed);
+
+  // Static constructors
+  static NAN_METHOD(FromImage);
 
   // Wrapped object
   QPixmap* q_;
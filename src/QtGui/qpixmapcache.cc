@@ -0,0 +1,188 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "../qt_v8.h"
+#include "qpixmapcache.h"
+#include "qpixmap.h"
+
+using namespace v8;
+
+double QPixmapCacheWrap::hits_ = 0;
+double QPixmapCacheWrap::misses_ = 0;
+double QPixmapCacheWrap::insertions_ = 0;
+double QPixmapCacheWrap::evicted_misses_ = 0;
+QCache<QString, bool> QPixmapCacheWrap::keys_;
+
+void QPixmapCacheWrap::SetKeyLimit(int cache_limit) {
+  keys_.setMaxCost(qMax(1024, cache_limit));
+}
+
+NAN_MODULE_INIT(QPixmapCacheWrap::Initialize) {
+  Local<Object> cache = Nan::New<Object>();
+
+  Nan::SetMethod(cache, "find", Find);
+  Nan::SetMethod(cache, "insert", Insert);
+  Nan::SetMethod(cache, "remove", Remove);
+  Nan::SetMethod(cache, "clear", Clear);
+  Nan::SetMethod(cache, "cacheLimit", CacheLimit);
+  Nan::SetMethod(cache, "setCacheLimit", SetCacheLimit);
+  Nan::SetMethod(cache, "stats", Stats);
+  Nan::SetMethod(cache, "resetStats", ResetStats);
+
+  Nan::Set(target, Nan::New("QPixmapCache").ToLocalChecked(), cache);
+}
+
+// Supported implementations:
+//   find ( QString key )
+// Returns a QPixmap sharing the cached pixels, or null
+NAN_METHOD(QPixmapCacheWrap::Find) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  if (!info[0]->IsString())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPixmapCache::Find: bad argument").ToLocalChecked()));
+
+  QString key = qt_v8::ToQString(info[0]->ToString());
+  QPixmap pixmap;
+
+  if (!QPixmapCache::find(key, &pixmap)) {
+    misses_++;
+    if (keys_.remove(key))
+      evicted_misses_++;
+
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  hits_++;
+  info.GetReturnValue().Set(QPixmapWrap::NewInstance(pixmap));
+}
+
+// Supported implementations:
+//   insert ( QString key, QPixmap pixmap )
+// Returns false if the pixmap is larger than the whole cache
+NAN_METHOD(QPixmapCacheWrap::Insert) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  if (!info[0]->IsString() || 
+      !qt_v8::HasTag(info[1], &QPixmapWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPixmapCache::Insert: bad arguments").ToLocalChecked()));
+
+  QString key = qt_v8::ToQString(info[0]->ToString());
+  QPixmap* pixmap = ObjectWrap::Unwrap<QPixmapWrap>(
+      info[1]->ToObject())->GetWrapped();
+
+  // Sized here rather than in Initialize(), which also runs on worker 
+  // threads; keys_ is only touched on the QApplication's thread
+  SetKeyLimit(QPixmapCache::cacheLimit());
+
+  bool inserted = QPixmapCache::insert(key, *pixmap);
+  if (inserted) {
+    insertions_++;
+    keys_.insert(key, new bool(true), 1);
+  }
+
+  info.GetReturnValue().Set(Nan::New(inserted));
+}
+
+NAN_METHOD(QPixmapCacheWrap::Remove) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  if (!info[0]->IsString())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPixmapCache::Remove: bad argument").ToLocalChecked()));
+
+  QString key = qt_v8::ToQString(info[0]->ToString());
+  QPixmapCache::remove(key);
+  keys_.remove(key);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QPixmapCacheWrap::Clear) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  QPixmapCache::clear();
+  keys_.clear();
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Limit in kilobytes
+NAN_METHOD(QPixmapCacheWrap::CacheLimit) {
+  info.GetReturnValue().Set(Nan::New(QPixmapCache::cacheLimit()));
+}
+
+NAN_METHOD(QPixmapCacheWrap::SetCacheLimit) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  if (!info[0]->IsNumber() || info[0]->Int32Value() < 0)
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QPixmapCache::SetCacheLimit: bad argument").ToLocalChecked()));
+
+  QPixmapCache::setCacheLimit(info[0]->Int32Value());
+  SetKeyLimit(info[0]->Int32Value());
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Returns { hits, misses, insertions, evictedMisses }. evictedMisses 
+// counts the find() misses on keys that were recently inserted and not 
+// removed since, i.e. entries Qt evicted that were asked for again; 
+// evictions nobody notices aren't counted.
+NAN_METHOD(QPixmapCacheWrap::Stats) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  Local<Object> stats = Nan::New<Object>();
+
+  Nan::Set(stats, Nan::New("hits").ToLocalChecked(), Nan::New(hits_));
+  Nan::Set(stats, Nan::New("misses").ToLocalChecked(), Nan::New(misses_));
+  Nan::Set(stats, Nan::New("insertions").ToLocalChecked(), 
+      Nan::New(insertions_));
+  Nan::Set(stats, Nan::New("evictedMisses").ToLocalChecked(), 
+      Nan::New(evicted_misses_));
+
+  info.GetReturnValue().Set(stats);
+}
+
+NAN_METHOD(QPixmapCacheWrap::ResetStats) {
+  if (!qt_v8::RequireGuiThread("QPixmapCache"))
+    return;
+
+  hits_ = misses_ = insertions_ = evicted_misses_ = 0;
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <QCache>
+#include <QPixmapCache>
+#include <QString>
+
+//
+// QPixmapCacheWrap
+// QPixmapCache is all static, so it's exposed as a plain object 
+// (qt.QPixmapCache) rather than a constructor. Qt owns the entries and 
+// evicts least recently used pixmaps past the cache limit, so cached 
+// pixmaps don't pin JS objects.
+//
+class QPixmapCacheWrap {
+ public:
+  static NAN_MODULE_INIT(Initialize);
+
+ private:
+  static NAN_METHOD(Find);
+  static NAN_METHOD(Insert);
+  static NAN_METHOD(Remove);
+  static NAN_METHOD(Clear);
+  static NAN_METHOD(CacheLimit);
+  static NAN_METHOD(SetCacheLimit);
+  static NAN_METHOD(Stats);
+  static NAN_METHOD(ResetStats);
+
+  // Counters reported by stats()
+  static double hits_;
+  static double misses_;
+  static double insertions_;
+  static double evicted_misses_;
+
+  // Recently inserted keys that weren't removed. Qt doesn't report 
+  // evictions, so a find() miss on one of these counts as an evicted 
+  // miss. Bounded (one key per KB of cache limit, at least 1024) and 
+  // least recently inserted keys are forgotten first.
+  static QCache<QString, bool> keys_;
+  static void SetKeyLimit(int cache_limit);
+};
@@ -0,0 +1,155 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "../qt_v8.h"
+#include "qstatictext.h"
+#include "qfont.h"
+
+using namespace v8;
+
+qt_v8::PerIsolate<FunctionTemplate> QStaticTextWrap::prototype;
+qt_v8::PerIsolate<Function> QStaticTextWrap::constructor;
+
+// Supported implementations:
+//   QStaticText ( )
+//   QStaticText ( QString text, QFont font = null, qreal width = -1 )
+QStaticTextWrap::QStaticTextWrap(Nan::NAN_METHOD_ARGS_TYPE info) 
+    : q_(NULL), has_font_(false) {
+  q_ = new QStaticText();
+
+  if (info[0]->IsString())
+    q_->setText(qt_v8::ToQString(info[0]->ToString()));
+
+  if (qt_v8::HasTag(info[1], &QFontWrap::prototype)) {
+    font_ = *ObjectWrap::Unwrap<QFontWrap>(info[1]->ToObject())->GetWrapped();
+    has_font_ = true;
+  }
+
+  if (info[2]->IsNumber())
+    q_->setTextWidth(info[2]->NumberValue());
+
+  Prepare();
+}
+
+QStaticTextWrap::~QStaticTextWrap() {
+  delete q_;
+}
+
+// Lays the text out now rather than on first draw. Without a font the 
+// layout is redone if the painter's font turns out to be different.
+void QStaticTextWrap::Prepare() {
+  q_->prepare(QTransform(), font_);
+}
+
+NAN_MODULE_INIT(QStaticTextWrap::Initialize) {
+  // Prepare constructor template
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("QStaticText").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
+
+  // Prototype
+  Nan::SetPrototypeMethod(tpl, "text", Text);
+  Nan::SetPrototypeMethod(tpl, "setText", SetText);
+  Nan::SetPrototypeMethod(tpl, "textWidth", TextWidth);
+  Nan::SetPrototypeMethod(tpl, "setTextWidth", SetTextWidth);
+  Nan::SetPrototypeMethod(tpl, "width", Width);
+  Nan::SetPrototypeMethod(tpl, "height", Height);
+
+  prototype.Reset(tpl);
+  Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
+  constructor.Reset(function);
+  Nan::Set(target, Nan::New("QStaticText").ToLocalChecked(), function);
+}
+
+NAN_METHOD(QStaticTextWrap::New) {
+  if (!qt_v8::RequireTextThread("QStaticText"))
+    return;
+
+  QStaticTextWrap* w = new QStaticTextWrap(info);
+  w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+NAN_METHOD(QStaticTextWrap::Text) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(qt_v8::FromQString(q->text()));
+}
+
+NAN_METHOD(QStaticTextWrap::SetText) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  if (!info[0]->IsString())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QStaticText::SetText: bad argument").ToLocalChecked()));
+
+  q->setText(qt_v8::ToQString(info[0]->ToString()));
+  w->Prepare();
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(QStaticTextWrap::TextWidth) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->textWidth()));
+}
+
+// A negative width disables wrapping
+NAN_METHOD(QStaticTextWrap::SetTextWidth) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QStaticText::SetTextWidth: bad argument").ToLocalChecked()));
+
+  q->setTextWidth(info[0]->NumberValue());
+  w->Prepare();
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// Size of the laid out text
+NAN_METHOD(QStaticTextWrap::Width) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->size().width()));
+}
+
+NAN_METHOD(QStaticTextWrap::Height) {
+  QStaticTextWrap* w = ObjectWrap::Unwrap<QStaticTextWrap>(info.This());
+  QStaticText* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->size().height()));
+}
@@ -0,0 +1,518 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <QPolygonF>
+#include "qtransform.h"
+#include "qmatrix.h"
+#include "../qt_v8.h"
+
+using namespace v8;
+
+qt_v8::PerIsolate<FunctionTemplate> QTransformWrap::prototype;
+qt_v8::PerIsolate<Function> QTransformWrap::constructor;
+
+// Supported implementations:
+//   QTransform ( )
+//   QTransform ( qreal m11, qreal m12, qreal m21, qreal m22, qreal dx, qreal dy )
+//   QTransform ( qreal m11, qreal m12, qreal m13, qreal m21, qreal m22, 
+//                qreal m23, qreal m31, qreal m32, qreal m33 = 1 )
+//   QTransform ( QTransform transform )
+//   QTransform ( QMatrix matrix )
+QTransformWrap::QTransformWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
+  if (info.Length() == 0) {
+    // QTransform ( )
+
+    q_ = new QTransform;
+  } else if (qt_v8::HasTag(info[0], &QTransformWrap::prototype)) {
+    // QTransform ( QTransform transform )
+
+    QTransformWrap* q_wrap = ObjectWrap::Unwrap<QTransformWrap>(
+        info[0]->ToObject());
+
+    q_ = new QTransform(*q_wrap->GetWrapped());
+  } else if (qt_v8::HasTag(info[0], &QMatrixWrap::prototype)) {
+    // QTransform ( QMatrix matrix )
+
+    QMatrixWrap* matrix_wrap = ObjectWrap::Unwrap<QMatrixWrap>(
+        info[0]->ToObject());
+
+    q_ = new QTransform(*matrix_wrap->GetWrapped());
+  } else if (info.Length() == 6) {
+    // QTransform ( qreal m11, qreal m12, qreal m21, qreal m22, qreal dx, qreal dy )
+
+    q_ = new QTransform(info[0]->NumberValue(), info[1]->NumberValue(),
+                        info[2]->NumberValue(), info[3]->NumberValue(),
+                        info[4]->NumberValue(), info[5]->NumberValue());
+  } else if (info.Length() == 8 || info.Length() == 9) {
+    // QTransform ( qreal m11, ..., qreal m33 = 1 )
+
+    q_ = new QTransform(info[0]->NumberValue(), info[1]->NumberValue(),
+                        info[2]->NumberValue(), info[3]->NumberValue(),
+                        info[4]->NumberValue(), info[5]->NumberValue(),
+                        info[6]->NumberValue(), info[7]->NumberValue(),
+                        info.Length() == 9 ? info[8]->NumberValue() : 1.0);
+  } else {
+    Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTransform::QTransform: bad arguments").ToLocalChecked()));
+    q_ = new QTransform;
+  }
+}
+
+QTransformWrap::~QTransformWrap() {
+  delete q_;
+}
+
+NAN_MODULE_INIT(QTransformWrap::Initialize) {
+  // Prepare constructor template
+  Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+  tpl->SetClassName(Nan::New("QTransform").ToLocalChecked());
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
+
+  // Prototype
+  Nan::SetPrototypeMethod(tpl, "m11", M11);
+  Nan::SetPrototypeMethod(tpl, "m12", M12);
+  Nan::SetPrototypeMethod(tpl, "m13", M13);
+  Nan::SetPrototypeMethod(tpl, "m21", M21);
+  Nan::SetPrototypeMethod(tpl, "m22", M22);
+  Nan::SetPrototypeMethod(tpl, "m23", M23);
+  Nan::SetPrototypeMethod(tpl, "m31", M31);
+  Nan::SetPrototypeMethod(tpl, "m32", M32);
+  Nan::SetPrototypeMethod(tpl, "m33", M33);
+  Nan::SetPrototypeMethod(tpl, "dx", Dx);
+  Nan::SetPrototypeMethod(tpl, "dy", Dy);
+  Nan::SetPrototypeMethod(tpl, "type", Type);
+  Nan::SetPrototypeMethod(tpl, "isIdentity", IsIdentity);
+  Nan::SetPrototypeMethod(tpl, "isAffine", IsAffine);
+  Nan::SetPrototypeMethod(tpl, "isInvertible", IsInvertible);
+  Nan::SetPrototypeMethod(tpl, "determinant", Determinant);
+  Nan::SetPrototypeMethod(tpl, "translate", Translate);
+  Nan::SetPrototypeMethod(tpl, "scale", Scale);
+  Nan::SetPrototypeMethod(tpl, "rotate", Rotate);
+  Nan::SetPrototypeMethod(tpl, "shear", Shear);
+  Nan::SetPrototypeMethod(tpl, "inverted", Inverted);
+  Nan::SetPrototypeMethod(tpl, "multiply", Multiply);
+  Nan::SetPrototypeMethod(tpl, "map", Map);
+  Nan::SetPrototypeMethod(tpl, "mapRects", MapRects);
+
+  prototype.Reset(tpl);
+  Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
+  constructor.Reset(function);
+  Nan::Set(target, Nan::New("QTransform").ToLocalChecked(), function);
+
+  // Static constructors
+  Nan::SetMethod(function, "quadToQuad", QuadToQuad);
+}
+
+NAN_METHOD(QTransformWrap::New) {
+  QTransformWrap* w = new QTransformWrap(info);
+  w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
+}
+
+Handle<Value> QTransformWrap::NewInstance(QTransform q) {
+  Nan::EscapableHandleScope scope;
+  
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
+  QTransformWrap* w = node::ObjectWrap::Unwrap<QTransformWrap>(instance);
+  w->SetWrapped(q);
+
+  return scope.Escape(instance);
+}
+
+NAN_METHOD(QTransformWrap::M11) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m11()));
+}
+
+NAN_METHOD(QTransformWrap::M12) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m12()));
+}
+
+NAN_METHOD(QTransformWrap::M13) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m13()));
+}
+
+NAN_METHOD(QTransformWrap::M21) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m21()));
+}
+
+NAN_METHOD(QTransformWrap::M22) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m22()));
+}
+
+NAN_METHOD(QTransformWrap::M23) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m23()));
+}
+
+NAN_METHOD(QTransformWrap::M31) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m31()));
+}
+
+NAN_METHOD(QTransformWrap::M32) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m32()));
+}
+
+NAN_METHOD(QTransformWrap::M33) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->m33()));
+}
+
+NAN_METHOD(QTransformWrap::Dx) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->dx()));
+}
+
+NAN_METHOD(QTransformWrap::Dy) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->dy()));
+}
+
+// Returns a qt.QTransform.TransformationType
+NAN_METHOD(QTransformWrap::Type) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New((int)q->type()));
+}
+
+NAN_METHOD(QTransformWrap::IsIdentity) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->isIdentity()));
+}
+
+NAN_METHOD(QTransformWrap::IsAffine) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->isAffine()));
+}
+
+NAN_METHOD(QTransformWrap::IsInvertible) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->isInvertible()));
+}
+
+NAN_METHOD(QTransformWrap::Determinant) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  info.GetReturnValue().Set(Nan::New(q->determinant()));
+}
+
+NAN_METHOD(QTransformWrap::Translate) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  q->translate(info[0]->NumberValue(), info[1]->NumberValue());
+
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(QTransformWrap::Scale) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  q->scale(info[0]->NumberValue(), info[1]->NumberValue());
+
+  info.GetReturnValue().Set(info.This());
+}
+
+// Supported versions:
+//   rotate( qreal degrees, Qt::Axis axis = Qt::ZAxis )
+// Rotating around the X or Y axis makes the transform projective
+NAN_METHOD(QTransformWrap::Rotate) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  Qt::Axis axis = info[1]->IsNumber() ? 
+      (Qt::Axis)info[1]->Int32Value() : Qt::ZAxis;
+
+  q->rotate(info[0]->NumberValue(), axis);
+
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(QTransformWrap::Shear) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  q->shear(info[0]->NumberValue(), info[1]->NumberValue());
+
+  info.GetReturnValue().Set(info.This());
+}
+
+// Returns a new QTransform, or null when this one isn't invertible
+NAN_METHOD(QTransformWrap::Inverted) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  bool invertible;
+  QTransform inverse = q->inverted(&invertible);
+
+  if (!invertible) {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  info.GetReturnValue().Set(NewInstance(inverse));
+}
+
+// Supported versions:
+//   multiply( QTransform other )
+// Returns this * other: a new transform that applies this one, then other
+NAN_METHOD(QTransformWrap::Multiply) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  if (!qt_v8::HasTag(info[0], &QTransformWrap::prototype))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTransform::Multiply: bad argument").ToLocalChecked()));
+
+  QTransform* other = ObjectWrap::Unwrap<QTransformWrap>(
+      info[0]->ToObject())->GetWrapped();
+
+  info.GetReturnValue().Set(NewInstance(*q * *other));
+}
+
+// Coefficients of a QTransform as doubles, whatever qreal is
+struct Coefficients {
+  explicit Coefficients(const QTransform& t)
+      : m11(t.m11()), m12(t.m12()), m13(t.m13()), 
+        m21(t.m21()), m22(t.m22()), m23(t.m23()),
+        m31(t.m31()), m32(t.m32()), m33(t.m33()) {}
+
+  double m11, m12, m13, m21, m22, m23, m31, m32, m33;
+};
+
+// Maps count x, y pairs from src into dst, which may be src. The affine 
+// loop has no branches and no calls so the compiler can vectorize it.
+static void MapPoints(const QTransform& t, const double* src, double* dst, 
+    size_t count) {
+  const Coefficients m(t);
+
+  if (t.isAffine()) {
+    for (size_t i = 0; i < count; i++) {
+      double x = src[i * 2], y = src[i * 2 + 1];
+      dst[i * 2] = m.m11 * x + m.m21 * y + m.m31;
+      dst[i * 2 + 1] = m.m12 * x + m.m22 * y + m.m32;
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    double x = src[i * 2], y = src[i * 2 + 1];
+    double w = 1. / (m.m13 * x + m.m23 * y + m.m33);
+    dst[i * 2] = (m.m11 * x + m.m21 * y + m.m31) * w;
+    dst[i * 2 + 1] = (m.m12 * x + m.m22 * y + m.m32) * w;
+  }
+}
+
+// Maps count x, y, width, height rects from src into dst, which may be 
+// src, as the bounding rect of each mapped rect (see QTransform::mapRect).
+// Projective transforms map the four corners and aren't clipped against 
+// the w = 0 plane.
+static void MapRects(const QTransform& t, const double* src, double* dst, 
+    size_t count) {
+  const Coefficients m(t);
+
+  if (t.isAffine()) {
+    // The mapped origin plus the mapped width and height vectors; their 
+    // negative components extend the box to the left and top
+    for (size_t i = 0; i < count; i++) {
+      const double* r = src + i * 4;
+      double x = r[0], y = r[1], w = r[2], h = r[3];
+      double wx = m.m11 * w, wy = m.m12 * w;
+      double hx = m.m21 * h, hy = m.m22 * h;
+      double* d = dst + i * 4;
+      d[0] = m.m11 * x + m.m21 * y + m.m31 + qMin(wx, 0.) + qMin(hx, 0.);
+      d[1] = m.m12 * x + m.m22 * y + m.m32 + qMin(wy, 0.) + qMin(hy, 0.);
+      d[2] = qAbs(wx) + qAbs(hx);
+      d[3] = qAbs(wy) + qAbs(hy);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const double* r = src + i * 4;
+    double corners[8] = {
+      r[0], r[1],  r[0] + r[2], r[1],
+      r[0], r[1] + r[3],  r[0] + r[2], r[1] + r[3]
+    };
+    MapPoints(t, corners, corners, 4);
+
+    double x0 = corners[0], y0 = corners[1], x1 = x0, y1 = y0;
+    for (int c = 1; c < 4; c++) {
+      x0 = qMin(x0, corners[c * 2]);
+      x1 = qMax(x1, corners[c * 2]);
+      y0 = qMin(y0, corners[c * 2 + 1]);
+      y1 = qMax(y1, corners[c * 2 + 1]);
+    }
+
+    double* d = dst + i * 4;
+    d[0] = x0;
+    d[1] = y0;
+    d[2] = x1 - x0;
+    d[3] = y1 - y0;
+  }
+}
+
+// Checks map()/mapRects() arguments: src is a Float64Array of whole 
+// tuples, dst (optional) a Float64Array of the same length. Returns 
+// the array to write to.
+static bool MapArguments(Nan::NAN_METHOD_ARGS_TYPE info, size_t tuple, 
+    Local<Value>* target) {
+  if (!info[0]->IsFloat64Array())
+    return false;
+
+  size_t length = Local<Float64Array>::Cast(info[0])->Length();
+  if (length % tuple)
+    return false;
+
+  if (info[1]->IsUndefined()) {
+    *target = info[0];
+    return true;
+  }
+
+  if (!info[1]->IsFloat64Array() || 
+      Local<Float64Array>::Cast(info[1])->Length() != length)
+    return false;
+
+  *target = info[1];
+  return true;
+}
+
+// Supported versions:
+//   map( Float64Array xy, Float64Array dst = xy )
+// Maps the [x0, y0, x1, y1, ...] points in place, or into dst; returns 
+// the array written
+NAN_METHOD(QTransformWrap::Map) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  Local<Value> target;
+  if (!MapArguments(info, 2, &target))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTransform::Map: bad arguments").ToLocalChecked()));
+
+  Nan::TypedArrayContents<double> src(info[0]);
+  Nan::TypedArrayContents<double> dst(target);
+
+  MapPoints(*q, *src, *dst, src.length() / 2);
+
+  info.GetReturnValue().Set(target);
+}
+
+// Supported versions:
+//   mapRects( Float64Array xywh, Float64Array dst = xywh )
+// Maps the [x, y, width, height, ...] rects in place, or into dst, to 
+// their bounding rects; returns the array written
+NAN_METHOD(QTransformWrap::MapRects) {
+  QTransformWrap* w = ObjectWrap::Unwrap<QTransformWrap>(info.This());
+  QTransform* q = w->GetWrapped();
+
+  Local<Value> target;
+  if (!MapArguments(info, 4, &target))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTransform::MapRects: bad arguments").ToLocalChecked()));
+
+  Nan::TypedArrayContents<double> src(info[0]);
+  Nan::TypedArrayContents<double> dst(target);
+
+  MapRects(*q, *src, *dst, src.length() / 4);
+
+  info.GetReturnValue().Set(target);
+}
+
+// Reads a Float64Array of 4 x, y corners
+static bool ReadQuad(Local<Value> value, QPolygonF* quad) {
+  if (!value->IsFloat64Array())
+    return false;
+
+  Nan::TypedArrayContents<double> coords(value);
+  if (coords.length() != 8)
+    return false;
+
+  for (int i = 0; i < 4; i++)
+    *quad << QPointF((*coords)[i * 2], (*coords)[i * 2 + 1]);
+
+  return true;
+}
+
+// Supported versions:
+//   QTransform.quadToQuad( Float64Array from, Float64Array to )
+// Returns the projective transform taking the 4 corners of from onto 
+// those of to, or null when there is none
+NAN_METHOD(QTransformWrap::QuadToQuad) {
+  QPolygonF from, to;
+
+  if (!ReadQuad(info[0], &from) || !ReadQuad(info[1], &to))
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTransform::QuadToQuad: bad arguments").ToLocalChecked()));
+
+  QTransform result;
+  if (!QTransform::quadToQuad(from, to, result)) {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  info.GetReturnValue().Set(NewInstance(result));
+}
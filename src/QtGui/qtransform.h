@@ -0,0 +1,85 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include "../qt_v8.h"
+#include <QTransform>
+
+class QTransformWrap : public node::ObjectWrap {
+ public:
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
+  static NAN_MODULE_INIT(Initialize);
+  QTransform* GetWrapped() const { return q_; };
+  void SetWrapped(QTransform q) { 
+    if (q_) delete q_; 
+    q_ = new QTransform(q); 
+  };
+  static v8::Handle<v8::Value> NewInstance(QTransform q);
+
+ private:
+  static qt_v8::PerIsolate<v8::Function> constructor;
+  QTransformWrap(Nan::NAN_METHOD_ARGS_TYPE info);
+  ~QTransformWrap();
+  static NAN_METHOD(New);
+
+  // Wrapped methods
+  static NAN_METHOD(M11);
+  static NAN_METHOD(M12);
+  static NAN_METHOD(M13);
+  static NAN_METHOD(M21);
+  static NAN_METHOD(M22);
+  static NAN_METHOD(M23);
+  static NAN_METHOD(M31);
+  static NAN_METHOD(M32);
+  static NAN_METHOD(M33);
+  static NAN_METHOD(Dx);
+  static NAN_METHOD(Dy);
+  static NAN_METHOD(Type);
+  static NAN_METHOD(IsIdentity);
+  static NAN_METHOD(IsAffine);
+  static NAN_METHOD(IsInvertible);
+  static NAN_METHOD(Determinant);
+  static NAN_METHOD(Translate);
+  static NAN_METHOD(Scale);
+  static NAN_METHOD(Rotate);
+  static NAN_METHOD(Shear);
+  static NAN_METHOD(Inverted);
+  static NAN_METHOD(Multiply);
+  static NAN_METHOD(Map);
+  static NAN_METHOD(MapRects);
+
+  // Static constructors
+  static NAN_METHOD(QuadToQuad);
+
+  // Wrapped object
+  QTransform* q_;
+};
@@ -0,0 +1,394 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <QByteArray>
+#include <qmath.h>
+#include <string.h>
+#include "svgpath.h"
+
+namespace svgpath {
+
+static inline bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static inline bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+class Parser {
+ public:
+  Parser(const QByteArray& d) : p_(d.constData()), end_(p_ + d.size()), 
+      start_(p_) {}
+
+  bool AtEnd() {
+    SkipSpace();
+    return p_ >= end_;
+  }
+
+  // Current offset, for error messages
+  int Offset() const { return static_cast<int>(p_ - start_); }
+
+  bool Command(char* command) {
+    SkipSpace();
+    if (p_ < end_ && IsCommand(*p_)) {
+      *command = *p_++;
+      return true;
+    }
+    return false;
+  }
+
+  // True if another number follows, i.e. the previous command repeats
+  bool NumberFollows() {
+    SkipSeparators();
+    return p_ < end_ && (IsDigit(*p_) || *p_ == '-' || *p_ == '+' || 
+        *p_ == '.');
+  }
+
+  // Parsed by hand: strtod() follows the C locale, which QApplication 
+  // sets from the environment, so it may expect a decimal comma
+  bool Number(qreal* value) {
+    SkipSeparators();
+    const char* p = p_;
+    bool negative = false, digits = false;
+    double mantissa = 0;
+    int exponent = 0;
+
+    if (p < end_ && (*p == '-' || *p == '+'))
+      negative = *p++ == '-';
+    for (; p < end_ && IsDigit(*p); p++, digits = true)
+      mantissa = mantissa * 10 + (*p - '0');
+    if (p < end_ && *p == '.') {
+      for (p++; p < end_ && IsDigit(*p); p++, digits = true) {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+    }
+
+    if (!digits)
+      return false;
+
+    if (p < end_ && (*p == 'e' || *p == 'E')) {
+      const char* e = p + 1;
+      bool negative_exponent = false;
+      int value = 0;
+
+      if (e < end_ && (*e == '-' || *e == '+'))
+        negative_exponent = *e++ == '-';
+      if (e < end_ && IsDigit(*e)) {
+        for (; e < end_ && IsDigit(*e); e++)
+          value = qMin(value * 10 + (*e - '0'), 1000);
+        exponent = qBound(-2000, 
+            exponent + (negative_exponent ? -value : value), 2000);
+        p = e;
+      }
+    }
+
+    // Dividing by 10^n rounds once, like strtod() for short numbers; 
+    // multiplying by the inexact 10^-n would make "0.3" 0.30000000000000004
+    if (exponent > 0)
+      mantissa *= qPow(10.0, exponent);
+    else if (exponent >= -308)
+      mantissa /= qPow(10.0, -exponent);
+    else
+      mantissa = mantissa / 1e308 / qPow(10.0, -exponent - 308);
+
+    p_ = p;
+    *value = negative ? -mantissa : mantissa;
+    return true;
+  }
+
+  // Arc flags may be written without separators, e.g. "a1 1 0 011 1"
+  bool Flag(bool* value) {
+    SkipSeparators();
+    if (p_ < end_ && (*p_ == '0' || *p_ == '1')) {
+      *value = *p_++ == '1';
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  static bool IsCommand(char c) {
+    switch (c) {
+      case 'M': case 'm': case 'L': case 'l': case 'H': case 'h':
+      case 'V': case 'v': case 'C': case 'c': case 'S': case 's':
+      case 'Q': case 'q': case 'T': case 't': case 'A': case 'a':
+      case 'Z': case 'z':
+        return true;
+    }
+    return false;
+  }
+
+  void SkipSpace() {
+    while (p_ < end_ && IsSpace(*p_))
+      p_++;
+  }
+
+  void SkipSeparators() {
+    SkipSpace();
+    if (p_ < end_ && *p_ == ',')
+      p_++;
+    SkipSpace();
+  }
+
+  const char* p_;
+  const char* end_;
+  const char* start_;
+};
+
+// Appends an SVG elliptical arc from the path's current position as 
+// cubics, per the SVG 1.1 implementation notes (F.6.5 and F.6.6)
+static void ArcTo(QPainterPath* path, qreal rx, qreal ry, qreal angle, 
+    bool large_arc, bool sweep, const QPointF& to) {
+  QPointF from = path->currentPosition();
+
+  if (from == to)
+    return;
+
+  rx = qAbs(rx);
+  ry = qAbs(ry);
+  if (rx == 0 || ry == 0) {
+    path->lineTo(to);
+    return;
+  }
+
+  qreal phi = angle * M_PI / 180;
+  qreal cos_phi = qCos(phi), sin_phi = qSin(phi);
+
+  // Step 1: (x1', y1')
+  qreal dx = (from.x() - to.x()) / 2, dy = (from.y() - to.y()) / 2;
+  qreal x1 = cos_phi * dx + sin_phi * dy;
+  qreal y1 = -sin_phi * dx + cos_phi * dy;
+
+  // Scale up radii that are too small to span the endpoints
+  qreal lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+  if (lambda > 1) {
+    rx *= qSqrt(lambda);
+    ry *= qSqrt(lambda);
+  }
+
+  // Step 2: (cx', cy')
+  qreal num = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+  qreal den = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+  qreal coef = qSqrt(qMax(qreal(0), num / den));
+  if (large_arc == sweep)
+    coef = -coef;
+  qreal cx1 = coef * rx * y1 / ry;
+  qreal cy1 = -coef * ry * x1 / rx;
+
+  // Step 3: (cx, cy)
+  qreal cx = cos_phi * cx1 - sin_phi * cy1 + (from.x() + to.x()) / 2;
+  qreal cy = sin_phi * cx1 + cos_phi * cy1 + (from.y() + to.y()) / 2;
+
+  // Step 4: start angle and sweep
+  qreal theta = qAtan2((y1 - cy1) / ry, (x1 - cx1) / rx);
+  qreal delta = qAtan2((-y1 - cy1) / ry, (-x1 - cx1) / rx) - theta;
+  if (sweep && delta < 0)
+    delta += 2 * M_PI;
+  else if (!sweep && delta > 0)
+    delta -= 2 * M_PI;
+
+  // One cubic per quarter turn at most
+  int segments = qMax(1, qCeil(qAbs(delta) / (M_PI / 2) - 0.001));
+  qreal step = delta / segments;
+  qreal k = 4.0 / 3.0 * qTan(step / 4);
+
+  for (int i = 0; i < segments; i++) {
+    qreal t1 = theta + i * step, t2 = t1 + step;
+    qreal cos1 = qCos(t1), sin1 = qSin(t1);
+    qreal cos2 = qCos(t2), sin2 = qSin(t2);
+
+    // Unit-circle control points, then scale, rotate and translate
+    QPointF p[3] = {
+      QPointF(cos1 - k * sin1, sin1 + k * cos1),
+      QPointF(cos2 + k * sin2, sin2 - k * cos2),
+      QPointF(cos2, sin2)
+    };
+    for (int j = 0; j < 3; j++) {
+      qreal x = p[j].x() * rx, y = p[j].y() * ry;
+      p[j] = QPointF(cos_phi * x - sin_phi * y + cx, 
+          sin_phi * x + cos_phi * y + cy);
+    }
+
+    // Land exactly on the endpoint
+    if (i == segments - 1)
+      p[2] = to;
+
+    path->cubicTo(p[0], p[1], p[2]);
+  }
+}
+
+bool Parse(const QString& d, QPainterPath* path, QString* error) {
+  QByteArray bytes = d.toLatin1();
+  Parser parser(bytes);
+
+  QPointF current = path->currentPosition();
+  QPointF start = current;        // of the current subpath
+  QPointF control = current;      // reflected by S and T
+  char command = 0, previous = 0;
+
+  while (!parser.AtEnd()) {
+    int offset = parser.Offset();
+
+    if (!parser.Command(&command)) {
+      // Implicit repeat of the previous command; after M it's L
+      if (!command || command == 'Z' || command == 'z' || 
+          !parser.NumberFollows()) {
+        *error = QString("unexpected character at offset %1").arg(offset);
+        return false;
+      }
+      if (command == 'M')
+        command = 'L';
+      else if (command == 'm')
+        command = 'l';
+    }
+
+    // Path data must begin with a moveto
+    if (!previous && command != 'M' && command != 'm') {
+      *error = QString("path data must start with 'M' at offset %1")
+          .arg(offset);
+      return false;
+    }
+
+    bool relative = command >= 'a';
+    QPointF origin = relative ? current : QPointF(0, 0);
+    qreal v[6];
+    bool large_arc, sweep;
+    bool ok = true;
+
+    switch (command) {
+      case 'M': case 'm':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]);
+        if (ok) {
+          current = origin + QPointF(v[0], v[1]);
+          start = current;
+          path->moveTo(current);
+        }
+        break;
+
+      case 'L': case 'l':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]);
+        if (ok) {
+          current = origin + QPointF(v[0], v[1]);
+          path->lineTo(current);
+        }
+        break;
+
+      case 'H': case 'h':
+        ok = parser.Number(&v[0]);
+        if (ok) {
+          current.setX(relative ? current.x() + v[0] : v[0]);
+          path->lineTo(current);
+        }
+        break;
+
+      case 'V': case 'v':
+        ok = parser.Number(&v[0]);
+        if (ok) {
+          current.setY(relative ? current.y() + v[0] : v[0]);
+          path->lineTo(current);
+        }
+        break;
+
+      case 'C': case 'c':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]) && 
+            parser.Number(&v[2]) && parser.Number(&v[3]) && 
+            parser.Number(&v[4]) && parser.Number(&v[5]);
+        if (ok) {
+          QPointF c1 = origin + QPointF(v[0], v[1]);
+          control = origin + QPointF(v[2], v[3]);
+          current = origin + QPointF(v[4], v[5]);
+          path->cubicTo(c1, control, current);
+        }
+        break;
+
+      case 'S': case 's':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]) && 
+            parser.Number(&v[2]) && parser.Number(&v[3]);
+        if (ok) {
+          bool smooth = previous && strchr("CcSs", previous);
+          QPointF c1 = smooth ? 2 * current - control : current;
+          control = origin + QPointF(v[0], v[1]);
+          current = origin + QPointF(v[2], v[3]);
+          path->cubicTo(c1, control, current);
+        }
+        break;
+
+      case 'Q': case 'q':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]) && 
+            parser.Number(&v[2]) && parser.Number(&v[3]);
+        if (ok) {
+          control = origin + QPointF(v[0], v[1]);
+          current = origin + QPointF(v[2], v[3]);
+          path->quadTo(control, current);
+        }
+        break;
+
+      case 'T': case 't':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]);
+        if (ok) {
+          bool smooth = previous && strchr("QqTt", previous);
+          control = smooth ? 2 * current - control : current;
+          current = origin + QPointF(v[0], v[1]);
+          path->quadTo(control, current);
+        }
+        break;
+
+      case 'A': case 'a':
+        ok = parser.Number(&v[0]) && parser.Number(&v[1]) && 
+            parser.Number(&v[2]) && parser.Flag(&large_arc) && 
+            parser.Flag(&sweep) && parser.Number(&v[3]) && 
+            parser.Number(&v[4]);
+        if (ok) {
+          QPointF to = origin + QPointF(v[3], v[4]);
+          ArcTo(path, v[0], v[1], v[2], large_arc, sweep, to);
+          current = to;
+        }
+        break;
+
+      case 'Z': case 'z':
+        path->closeSubpath();
+        current = start;
+        break;
+    }
+
+    if (!ok) {
+      *error = QString("bad arguments for '%1' at offset %2")
+          .arg(QChar(command)).arg(offset);
+      return false;
+    }
+
+    previous = command;
+  }
+
+  return true;
+}
+
+} // namespace
@@ -32,8 +32,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QSoundWrap::prototype;
-Nan::Persistent<Function> QSoundWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QSoundWrap::prototype;
+qt_v8::PerIsolate<Function> QSoundWrap::constructor;
 
 // Supported implementations:
 //   QSound ( QString filename )
@@ -49,7 +49,7 @@ NAN_MODULE_INIT(QSoundWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QSound").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "play", Play);
@@ -63,8 +63,12 @@ NAN_MODULE_INIT(QSoundWrap::Initialize) {
 }
 
 NAN_METHOD(QSoundWrap::New) {
+  if (!qt_v8::RequireGuiThread("QSound"))
+    return;
+
   QSoundWrap* w = new QSoundWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QSoundWrap::Play) {
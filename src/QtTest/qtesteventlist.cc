@@ -32,11 +32,36 @@
 #include "../qt_v8.h"
 #include "../QtWidgets/qwidget.h"
 #include "qtesteventlist.h"
+#include <QApplication>
+#include <QMouseEvent>
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QTestEventListWrap::prototype;
-Nan::Persistent<Function> QTestEventListWrap::constructor;
+//
+// MouseMoveEvent
+// QTest's own mouse moves only reposition the cursor, which the widget
+// sees only if the window system reports it back (never on Qt 4 or the
+// offscreen platform). Sending the event directly makes moves reliable.
+//
+class MouseMoveEvent : public QTestEvent {
+ public:
+  explicit MouseMoveEvent(const QPoint& pos) : pos_(pos) {}
+
+  void simulate(QWidget* widget) {
+    QMouseEvent event(QEvent::MouseMove, pos_, widget->mapToGlobal(pos_),
+        Qt::NoButton, QApplication::mouseButtons(),
+        QApplication::keyboardModifiers());
+    QApplication::sendEvent(widget, &event);
+  }
+
+  QTestEvent* clone() const { return new MouseMoveEvent(*this); }
+
+ private:
+  QPoint pos_;
+};
+
+qt_v8::PerIsolate<FunctionTemplate> QTestEventListWrap::prototype;
+qt_v8::PerIsolate<Function> QTestEventListWrap::constructor;
 
 QTestEventListWrap::QTestEventListWrap() {
   q_ = new QTestEventList();
@@ -50,11 +75,12 @@ NAN_MODULE_INIT(QTestEventListWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QTestEventList").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "addMouseClick", AddMouseClick);
   Nan::SetPrototypeMethod(tpl, "addKeyPress", AddKeyPress);
+  Nan::SetPrototypeMethod(tpl, "addMouseMove", AddMouseMove);
   Nan::SetPrototypeMethod(tpl, "simulate", Simulate);
 
   prototype.Reset(tpl);
@@ -66,6 +92,7 @@ NAN_MODULE_INIT(QTestEventListWrap::Initialize) {
 NAN_METHOD(QTestEventListWrap::New) {
   QTestEventListWrap* w = new QTestEventListWrap();
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QTestEventListWrap::AddMouseClick) {
@@ -91,13 +118,33 @@ NAN_METHOD(QTestEventListWrap::AddKeyPress) {
   info.GetReturnValue().Set(Nan::Undefined());
 }
 
+// Supported versions:
+//   addMouseMove( int x, int y )
+// Sends a QMouseEvent on simulate(), see MouseMoveEvent above.
+NAN_METHOD(QTestEventListWrap::AddMouseMove) {
+  QTestEventListWrap* w = ObjectWrap::Unwrap<QTestEventListWrap>(info.This());
+  QTestEventList* q = w->GetWrapped();
+
+  if (!info[0]->IsNumber() || !info[1]->IsNumber())
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTestEventList::AddMouseMove: bad arguments")
+          .ToLocalChecked()));
+
+  q->append(new MouseMoveEvent(
+      QPoint(info[0]->Int32Value(), info[1]->Int32Value())));
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
 NAN_METHOD(QTestEventListWrap::Simulate) {
   QTestEventListWrap* w = ObjectWrap::Unwrap<QTestEventListWrap>(info.This());
   QTestEventList* q = w->GetWrapped();
 
-  QWidgetWrap* widget_wrap = node::ObjectWrap::Unwrap<QWidgetWrap>(
-      info[0]->ToObject());
-  QWidget* widget = widget_wrap->GetWrapped();
+  QWidget* widget = QWidgetWrapBase::UnwrapWidget(info[0]);
+
+  if (!widget)
+    return Nan::ThrowError(Exception::TypeError(
+      Nan::New("QTestEventList::Simulate: bad argument").ToLocalChecked()));
 
   q->simulate(widget);
 
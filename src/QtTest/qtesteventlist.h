@@ -31,18 +31,19 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #define QT_GUI_LIB // necessary for QTestEventList
 #define QT_WIDGETS_LIB // necessary for QTestEventList
 #include <QTestEventList>
 
 class QTestEventListWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QTestEventList* GetWrapped() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QTestEventListWrap();
   ~QTestEventListWrap();
   static NAN_METHOD(New);
@@ -50,6 +51,7 @@ class QTestEventListWrap : public node::ObjectWrap {
   // Wrapped methods
   static NAN_METHOD(AddMouseClick);
   static NAN_METHOD(AddKeyPress);
+  static NAN_METHOD(AddMouseMove);
   static NAN_METHOD(Simulate);
 
   // Wrapped object
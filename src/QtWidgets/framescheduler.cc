@@ -0,0 +1,312 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <math.h>
+#include "framescheduler.h"
+#include "../qt_v8.h"
+
+using namespace v8;
+
+static qt_v8::IsolateData<FrameScheduler> schedulers;
+
+static void FreeTimer(uv_handle_t* handle) {
+  delete reinterpret_cast<uv_timer_t*>(handle);
+}
+
+FrameScheduler::FrameScheduler() 
+    : timer_(new uv_timer_t), scheduled_(false), in_tick_(false), fps_(60), 
+      deadline_(0), aligned_updates_(false), last_id_(0), frames_(0), 
+      dropped_(0), last_frame_ms_(0), total_frame_ms_(0), max_frame_ms_(0) {
+  uv_timer_init(Nan::GetCurrentEventLoop(), timer_);
+  timer_->data = this;
+}
+
+FrameScheduler::~FrameScheduler() {
+  for (int i = 0; i < requests_.size(); i++)
+    delete requests_[i].callback;
+
+  uv_timer_stop(timer_);
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_), FreeTimer);
+}
+
+NAN_MODULE_INIT(FrameScheduler::Initialize) {
+  Nan::SetMethod(target, "requestAnimationFrame", RequestAnimationFrame);
+  Nan::SetMethod(target, "cancelAnimationFrame", CancelAnimationFrame);
+  Nan::SetMethod(target, "setFrameRate", SetFrameRate);
+  Nan::SetMethod(target, "frameRate", FrameRate);
+  Nan::SetMethod(target, "setFrameAlignedUpdates", SetFrameAlignedUpdates);
+  Nan::SetMethod(target, "frameStats", FrameStats);
+  Nan::SetMethod(target, "resetFrameStats", ResetFrameStats);
+}
+
+// Milliseconds on the same monotonic clock as process.hrtime()
+double FrameScheduler::Now() {
+  return uv_hrtime() / 1e6;
+}
+
+bool FrameScheduler::QueueUpdate(QWidget* widget, const QRegion& region) {
+  FrameScheduler* scheduler = schedulers.Get();
+
+  if (!scheduler->aligned_updates_)
+    return false;
+
+  Update& update = scheduler->updates_[widget];
+  if (update.first.isNull()) {
+    update.first = widget;
+    update.second = QRegion();
+  }
+  update.second += region;
+
+  scheduler->Schedule(false);
+  return true;
+}
+
+void FrameScheduler::Schedule(bool continuing) {
+  // A running frame schedules the next one itself once it's done
+  if (scheduled_ || in_tick_)
+    return;
+
+  double interval = Interval();
+  double now = Now();
+
+  if (!continuing) {
+    deadline_ = (floor(now / interval) + 1) * interval;
+  } else if (now >= deadline_) {
+    // The frame ran over into the next slot(s)
+    double missed = floor((now - deadline_) / interval) + 1;
+    dropped_ += missed;
+    deadline_ += missed * interval;
+  }
+
+  scheduled_ = true;
+  uv_timer_start(timer_, OnTick, 
+      static_cast<uint64_t>(ceil(deadline_ - now)), 0);
+}
+
+void FrameScheduler::OnTick(uv_timer_t* handle) {
+  static_cast<FrameScheduler*>(handle->data)->Tick();
+}
+
+void FrameScheduler::Tick() {
+  Nan::HandleScope scope;
+
+  double interval = Interval();
+  double start = Now();
+
+  scheduled_ = false;
+  in_tick_ = true;
+
+  // The loop was busy past whole slots before the timer could fire
+  if (start - deadline_ >= interval) {
+    double missed = floor((start - deadline_) / interval);
+    dropped_ += missed;
+    deadline_ += missed * interval;
+  }
+
+  // Callbacks requested from here on wait for the next frame
+  running_.swap(requests_);
+
+  for (int i = 0; i < running_.size(); i++) {
+    Nan::Callback* callback = running_[i].callback;
+    if (!callback)
+      continue;  // Cancelled by an earlier callback
+
+    running_[i].callback = NULL;
+    Local<Value> argv[] = { Nan::New(start) };
+    callback->Call(1, argv);
+    delete callback;
+  }
+  running_.clear();
+
+  FlushUpdates(true);
+
+  last_frame_ms_ = Now() - start;
+  total_frame_ms_ += last_frame_ms_;
+  max_frame_ms_ = qMax(max_frame_ms_, last_frame_ms_);
+  frames_++;
+
+  in_tick_ = false;
+  deadline_ += interval;
+
+  if (!requests_.isEmpty() || !updates_.isEmpty())
+    Schedule(true);
+}
+
+// repaint: paint now, as part of a frame; otherwise hand the updates back 
+// to Qt
+void FrameScheduler::FlushUpdates(bool repaint) {
+  QHash<QWidget*, Update> updates;
+  updates.swap(updates_);
+
+  for (QHash<QWidget*, Update>::const_iterator it = updates.constBegin(); 
+      it != updates.constEnd(); ++it) {
+    QWidget* widget = it.value().first;
+    if (!widget)
+      continue;
+
+    if (repaint)
+      widget->repaint(it.value().second);
+    else
+      widget->update(it.value().second);
+  }
+}
+
+//
+// RequestAnimationFrame()
+// Runs callback(timestamp) at the start of the next frame, before widgets 
+// repaint. Returns an id for cancelAnimationFrame(). Never fires while 
+// app.exec() blocks node's loop (the default 'qt' event loop).
+//
+NAN_METHOD(FrameScheduler::RequestAnimationFrame) {
+  if (!info[0]->IsFunction()) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("requestAnimationFrame: bad argument").ToLocalChecked()));
+  }
+
+  FrameScheduler* scheduler = schedulers.Get();
+  Request request = { ++scheduler->last_id_, 
+      new Nan::Callback(info[0].As<Function>()) };
+  scheduler->requests_.append(request);
+  scheduler->Schedule(false);
+
+  info.GetReturnValue().Set(Nan::New(request.id));
+}
+
+NAN_METHOD(FrameScheduler::CancelAnimationFrame) {
+  FrameScheduler* scheduler = schedulers.Get();
+  int id = info[0]->Int32Value();
+
+  for (int i = 0; i < scheduler->requests_.size(); i++) {
+    if (scheduler->requests_[i].id == id) {
+      delete scheduler->requests_.takeAt(i).callback;
+      break;
+    }
+  }
+
+  // Requests of the current frame are only marked, the frame is 
+  // iterating over them
+  for (int i = 0; i < scheduler->running_.size(); i++) {
+    if (scheduler->running_[i].id == id) {
+      delete scheduler->running_[i].callback;
+      scheduler->running_[i].callback = NULL;
+      break;
+    }
+  }
+
+  // Nothing left to do: let the loop sleep
+  if (scheduler->scheduled_ && scheduler->requests_.isEmpty() && 
+      scheduler->updates_.isEmpty()) {
+    uv_timer_stop(scheduler->timer_);
+    scheduler->scheduled_ = false;
+  }
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+//
+// SetFrameRate()
+// Target frames per second, 1 to 1000. Defaults to 60.
+//
+NAN_METHOD(FrameScheduler::SetFrameRate) {
+  if (!info[0]->IsNumber() || !(info[0]->NumberValue() >= 1) || 
+      info[0]->NumberValue() > 1000) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("setFrameRate: bad argument").ToLocalChecked()));
+  }
+
+  FrameScheduler* scheduler = schedulers.Get();
+  scheduler->fps_ = info[0]->NumberValue();
+
+  // Realign a pending frame to the new grid
+  if (scheduler->scheduled_) {
+    uv_timer_stop(scheduler->timer_);
+    scheduler->scheduled_ = false;
+    scheduler->Schedule(false);
+  }
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+NAN_METHOD(FrameScheduler::FrameRate) {
+  info.GetReturnValue().Set(Nan::New(schedulers.Get()->fps_));
+}
+
+//
+// SetFrameAlignedUpdates()
+// When on, QWidget update() calls wait for the next frame, and each 
+// widget repaints once per frame whatever the number of calls. Off by 
+// default; turning it off hands pending updates back to Qt.
+//
+NAN_METHOD(FrameScheduler::SetFrameAlignedUpdates) {
+  FrameScheduler* scheduler = schedulers.Get();
+  scheduler->aligned_updates_ = info[0]->BooleanValue();
+
+  if (!scheduler->aligned_updates_)
+    scheduler->FlushUpdates(false);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+//
+// FrameStats()
+// Returns { fps, frames, dropped, lastFrameTime, averageFrameTime, 
+// maxFrameTime }. Frame times are the ms spent in callbacks and repaints.
+//
+NAN_METHOD(FrameScheduler::FrameStats) {
+  FrameScheduler* scheduler = schedulers.Get();
+  Local<Object> stats = Nan::New<Object>();
+
+  Nan::Set(stats, Nan::New("fps").ToLocalChecked(), 
+      Nan::New(scheduler->fps_));
+  Nan::Set(stats, Nan::New("frames").ToLocalChecked(), 
+      Nan::New(scheduler->frames_));
+  Nan::Set(stats, Nan::New("dropped").ToLocalChecked(), 
+      Nan::New(scheduler->dropped_));
+  Nan::Set(stats, Nan::New("lastFrameTime").ToLocalChecked(), 
+      Nan::New(scheduler->last_frame_ms_));
+  Nan::Set(stats, Nan::New("averageFrameTime").ToLocalChecked(), 
+      Nan::New(scheduler->frames_ ? 
+          scheduler->total_frame_ms_ / scheduler->frames_ : 0));
+  Nan::Set(stats, Nan::New("maxFrameTime").ToLocalChecked(), 
+      Nan::New(scheduler->max_frame_ms_));
+
+  info.GetReturnValue().Set(stats);
+}
+
+NAN_METHOD(FrameScheduler::ResetFrameStats) {
+  FrameScheduler* scheduler = schedulers.Get();
+
+  scheduler->frames_ = 0;
+  scheduler->dropped_ = 0;
+  scheduler->last_frame_ms_ = 0;
+  scheduler->total_frame_ms_ = 0;
+  scheduler->max_frame_ms_ = 0;
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <node.h>
+#include <nan.h>
+#include <uv.h>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QRegion>
+#include <QWidget>
+
+//
+// FrameScheduler
+// The frame clock behind qt.requestAnimationFrame(): a one-shot uv timer 
+// on node's loop, aimed at the next slot of a fixed grid at the target 
+// rate (qt.setFrameRate(), 60 by default). It only runs while there is 
+// work, so an idle app doesn't tick.
+//
+// A frame runs the callbacks requested before it started, then, with 
+// qt.setFrameAlignedUpdates(true), repaints each widget that asked for 
+// update() since the last frame once, with the union of its regions. A 
+// frame that starts or ends a whole slot late drops the slots it missed; 
+// qt.frameStats() counts them.
+//
+// Frames run from node's loop, so in the default 'qt' event loop mode no
+// frame fires while app.exec() blocks it; use eventLoop: 'libuv' or poll 
+// processEvents() from a timer instead.
+//
+class FrameScheduler {
+ public:
+  static NAN_MODULE_INIT(Initialize);
+
+  // Defers widget's update to the next frame. Returns false if updates 
+  // aren't frame aligned, and the caller should update() right away.
+  static bool QueueUpdate(QWidget* widget, const QRegion& region);
+
+  // One per isolate, see qt_v8::IsolateData
+  FrameScheduler();
+  ~FrameScheduler();
+
+ private:
+  struct Request {
+    int id;
+    Nan::Callback* callback;
+  };
+
+  typedef QPair<QPointer<QWidget>, QRegion> Update;
+
+  static NAN_METHOD(RequestAnimationFrame);
+  static NAN_METHOD(CancelAnimationFrame);
+  static NAN_METHOD(SetFrameRate);
+  static NAN_METHOD(FrameRate);
+  static NAN_METHOD(SetFrameAlignedUpdates);
+  static NAN_METHOD(FrameStats);
+  static NAN_METHOD(ResetFrameStats);
+
+  static void OnTick(uv_timer_t* handle);
+  static double Now();
+
+  // continuing: called at the end of a frame, so late slots are dropped
+  void Schedule(bool continuing);
+  void Tick();
+  void FlushUpdates(bool repaint);
+  double Interval() const { return 1000 / fps_; }
+
+  uv_timer_t* timer_;
+  bool scheduled_;
+  bool in_tick_;
+  double fps_;
+  double deadline_;  // ms on the Now() clock
+  bool aligned_updates_;
+  int last_id_;
+  QList<Request> requests_;
+  QList<Request> running_;
+  QHash<QWidget*, Update> updates_;
+
+  double frames_;
+  double dropped_;
+  double last_frame_ms_;
+  double total_frame_ms_;
+  double max_frame_ms_;
+};
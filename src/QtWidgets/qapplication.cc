@@ -27,18 +27,73 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qapplication.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QApplicationWrap::prototype;
-Nan::Persistent<Function> QApplicationWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QApplicationWrap::prototype;
+qt_v8::PerIsolate<Function> QApplicationWrap::constructor;
 
 int QApplicationWrap::argc_ = 0;
-char** QApplicationWrap::argv_ = NULL;
+char* QApplicationWrap::argv_[4] = { NULL, NULL, NULL, NULL };
+QByteArray QApplicationWrap::platform_;
+
+static char kProgramName[] = "node";
+static char kPlatformFlag[] = "-platform";
+
+// Headless applications never connect to a window system. On Qt 5 that 
+// means the "offscreen" QPA plugin (or whichever platform was asked for): 
+// widgets, QPixmap and QPainter all keep working on raster backing stores. 
+// Qt 4 has no platform plugins, so there the application is created with 
+// GUIenabled = false; only QImage based painting is usable, and creating 
+// a QPixmap or a widget is a Qt error.
+//
+// With libuv set, Qt's main thread events run from node's loop through a 
+// UvEventDispatcher (see uveventdispatcher.h) instead of app.exec() or 
+// processEvents() polling.
+QApplicationWrap::QApplicationWrap(bool headless, const QByteArray& platform,
+    bool libuv)
+    : headless_(headless) {
+#ifdef QT_UV_EVENT_DISPATCHER
+  dispatcher_ = NULL;
+  if (libuv) {
+    // Must be installed before the application creates its own
+    dispatcher_ = new UvEventDispatcher(Nan::GetCurrentEventLoop());
+    QCoreApplication::setEventDispatcher(dispatcher_);
+  }
+#else
+  Q_UNUSED(libuv);
+#endif
+
+  argc_ = 0;
+  argv_[argc_++] = kProgramName;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+  if (headless || !platform.isEmpty()) {
+    platform_ = platform.isEmpty() ? QByteArray("offscreen") : platform;
+    argv_[argc_++] = kPlatformFlag;
+    argv_[argc_++] = platform_.data();
+  }
+  argv_[argc_] = NULL;
 
-QApplicationWrap::QApplicationWrap() {
   q_ = new QApplication(argc_, argv_);
+
+#ifdef QT_UV_EVENT_DISPATCHER
+  if (dispatcher_) {
+    UvEventDispatcher* dispatcher = dispatcher_;
+    QObject::connect(q_, &QGuiApplication::lastWindowClosed, [dispatcher]() {
+      if (QGuiApplication::quitOnLastWindowClosed())
+        dispatcher->SetKeepAlive(false);
+    });
+  }
+#endif
+#else
+  Q_UNUSED(platform);
+  argv_[argc_] = NULL;
+
+  q_ = new QApplication(argc_, argv_, !headless);
+#endif
 }
 
 QApplicationWrap::~QApplicationWrap() {
@@ -49,11 +104,15 @@ NAN_MODULE_INIT(QApplicationWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QApplication").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
   
   // Prototype
   Nan::SetPrototypeMethod(tpl, "processEvents", ProcessEvents);
   Nan::SetPrototypeMethod(tpl, "exec", Exec);
+  Nan::SetPrototypeMethod(tpl, "quit", Quit);
+  Nan::SetPrototypeMethod(tpl, "eventLoop", EventLoop);
+  Nan::SetPrototypeMethod(tpl, "platformName", PlatformName);
+  Nan::SetPrototypeMethod(tpl, "isHeadless", IsHeadless);
   
   prototype.Reset(tpl);
   Local<Function> function = Nan::GetFunction(tpl).ToLocalChecked();
@@ -61,9 +120,62 @@ NAN_MODULE_INIT(QApplicationWrap::Initialize) {
   Nan::Set(target, Nan::New("QApplication").ToLocalChecked(), function);
 }
 
+// Supported versions:
+//   new QApplication()
+//   new QApplication( Object options )
+// Options:
+//   headless   true to run without a display server, false
+//   platform   Qt 5 platform plugin name, e.g. 'offscreen' or 'minimal'
+//   eventLoop  'qt' (default) or 'libuv' to dispatch Qt events from node's
+//              event loop; needs Qt 5 on X11 or a headless platform
 NAN_METHOD(QApplicationWrap::New) {
-  QApplicationWrap* w = new QApplicationWrap();
+  if (!qt_v8::RequireGuiThread("QApplication"))
+    return;
+
+  bool headless = false;
+  bool libuv = false;
+  QByteArray platform;
+
+  if (info[0]->IsObject()) {
+    Local<Object> options = info[0]->ToObject();
+    Local<Value> headless_value = Nan::Get(options, 
+        Nan::New("headless").ToLocalChecked()).ToLocalChecked();
+    Local<Value> platform_value = Nan::Get(options, 
+        Nan::New("platform").ToLocalChecked()).ToLocalChecked();
+    Local<Value> loop_value = Nan::Get(options, 
+        Nan::New("eventLoop").ToLocalChecked()).ToLocalChecked();
+
+    if (!platform_value->IsUndefined() && !platform_value->IsString())
+      return Nan::ThrowError(Exception::TypeError(
+          Nan::New("QApplication::QApplication: bad platform")
+              .ToLocalChecked()));
+
+    QString loop = loop_value->IsString() ? 
+        qt_v8::ToQString(loop_value->ToString()) : QString();
+    if (!loop_value->IsUndefined() && loop != "qt" && loop != "libuv")
+      return Nan::ThrowError(Exception::TypeError(
+          Nan::New("QApplication::QApplication: bad eventLoop")
+              .ToLocalChecked()));
+
+#ifndef QT_UV_EVENT_DISPATCHER
+    if (loop == "libuv")
+      return Nan::ThrowError(
+          "QApplication::QApplication: eventLoop 'libuv' needs Qt 5 on X11");
+#endif
+
+    libuv = loop == "libuv";
+    headless = headless_value->BooleanValue();
+    if (platform_value->IsString())
+      platform = qt_v8::ToQString(platform_value->ToString()).toLatin1();
+  } else if (!info[0]->IsUndefined()) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QApplication::QApplication: bad argument")
+            .ToLocalChecked()));
+  }
+
+  QApplicationWrap* w = new QApplicationWrap(headless, platform, libuv);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QApplicationWrap::ProcessEvents) {
@@ -75,11 +187,67 @@ NAN_METHOD(QApplicationWrap::ProcessEvents) {
   info.GetReturnValue().Set(Nan::Undefined());
 }
 
+// Blocks in Qt's event loop until quit(). With eventLoop 'libuv' events 
+// already run from node's loop, so exec() returns right away and just 
+// keeps the process alive until quit() or the last window is closed.
 NAN_METHOD(QApplicationWrap::Exec) {
   QApplicationWrap* w = ObjectWrap::Unwrap<QApplicationWrap>(info.This());
   QApplication* q = w->GetWrapped();
+
+#ifdef QT_UV_EVENT_DISPATCHER
+  if (w->dispatcher_) {
+    w->dispatcher_->SetKeepAlive(true);
+    info.GetReturnValue().Set(Nan::Undefined());
+    return;
+  }
+#endif
   
   q->exec();
   
   info.GetReturnValue().Set(Nan::Undefined());
 }
+
+NAN_METHOD(QApplicationWrap::Quit) {
+  QApplicationWrap* w = ObjectWrap::Unwrap<QApplicationWrap>(info.This());
+
+#ifdef QT_UV_EVENT_DISPATCHER
+  if (w->dispatcher_)
+    w->dispatcher_->SetKeepAlive(false);
+#endif
+
+  w->GetWrapped()->quit();
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
+// 'libuv' or 'qt'
+NAN_METHOD(QApplicationWrap::EventLoop) {
+  QApplicationWrap* w = ObjectWrap::Unwrap<QApplicationWrap>(info.This());
+  bool libuv = false;
+
+#ifdef QT_UV_EVENT_DISPATCHER
+  libuv = w->dispatcher_ != NULL;
+#else
+  Q_UNUSED(w);
+#endif
+
+  info.GetReturnValue().Set(
+      Nan::New(libuv ? "libuv" : "qt").ToLocalChecked());
+}
+
+// Name of the Qt 5 platform plugin in use ('offscreen', 'xcb', 'cocoa', 
+// ...). Qt 4 has no platform plugins and returns ''.
+NAN_METHOD(QApplicationWrap::PlatformName) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+  info.GetReturnValue().Set(qt_v8::FromQString(
+      QGuiApplication::platformName()));
+#else
+  info.GetReturnValue().Set(Nan::New("").ToLocalChecked());
+#endif
+}
+
+NAN_METHOD(QApplicationWrap::IsHeadless) {
+  QApplicationWrap* w = ObjectWrap::Unwrap<QApplicationWrap>(info.This());
+
+  info.GetReturnValue().Set(Nan::New(w->headless_));
+}
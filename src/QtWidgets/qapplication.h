@@ -31,26 +31,38 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QApplication>
+#include "../QtCore/uveventdispatcher.h"
 
 class QApplicationWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QApplication* GetWrapped() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
-  QApplicationWrap();
+  static qt_v8::PerIsolate<v8::Function> constructor;
+  QApplicationWrap(bool headless, const QByteArray& platform, bool libuv);
   ~QApplicationWrap();
   static NAN_METHOD(New);
 
   // Wrapped methods
   static NAN_METHOD(ProcessEvents);
   static NAN_METHOD(Exec);
+  static NAN_METHOD(Quit);
+  static NAN_METHOD(EventLoop);
+  static NAN_METHOD(PlatformName);
+  static NAN_METHOD(IsHeadless);
 
   // Wrapped object
   QApplication* q_;
+  bool headless_;
+#ifdef QT_UV_EVENT_DISPATCHER
+  UvEventDispatcher* dispatcher_;  // owned by Qt; NULL unless 'libuv'
+#endif
+  // QApplication keeps references to both for its whole lifetime
   static int argc_;
-  static char** argv_;
+  static char* argv_[4];
+  static QByteArray platform_;
 };
@@ -33,17 +33,15 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QBoxLayoutWrap::prototype;
-Nan::Persistent<Function> QBoxLayoutWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QBoxLayoutWrap::prototype;
+qt_v8::PerIsolate<Function> QBoxLayoutWrap::constructor;
 
 QBoxLayoutWrap::QBoxLayoutWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
   if (info.Length() >= 1 && info[0]->IsNumber()) {
     QWidget* parent = NULL;
     
-    if (info.Length() == 2 && qt_v8::InstanceOf(info[1], &QWidgetWrap::prototype)) {
-      QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-          info[1]->ToObject());
-      parent = widgetWrapper->GetWrapped();
+    if (info.Length() == 2) {
+      parent = QWidgetWrapBase::UnwrapWidget(info[1]);
     }
     
     q_ = new QBoxLayout((QBoxLayout::Direction) info[0]->NumberValue(), parent);
@@ -62,7 +60,7 @@ NAN_MODULE_INIT(QBoxLayoutWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QBoxLayout").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "addWidget", AddWidget);
@@ -77,8 +75,12 @@ NAN_MODULE_INIT(QBoxLayoutWrap::Initialize) {
 }
 
 NAN_METHOD(QBoxLayoutWrap::New) {
+  if (!qt_v8::RequireGuiThread("QBoxLayout"))
+    return;
+
   QBoxLayoutWrap* w = new QBoxLayoutWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 // Supported implementations:
@@ -88,15 +90,14 @@ NAN_METHOD(QBoxLayoutWrap::AddWidget) {
   QBoxLayoutWrap* w = node::ObjectWrap::Unwrap<QBoxLayoutWrap>(info.This());
   QBoxLayout* q = w->GetWrapped();
   
-  if (info.Length() >= 1 && qt_v8::InstanceOf(info[0], &QWidgetWrap::prototype)) {
-    QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-        info[0]->ToObject());
-  
+  QWidget* widget = QWidgetWrapBase::UnwrapWidget(info[0]);
+
+  if (widget) {
     if (info.Length() == 2 && info[1]->IsNumber()) {
-      q->addWidget(widgetWrapper->GetWrapped(), info[1]->NumberValue());
+      q->addWidget(widget, info[1]->NumberValue());
     }
     else {
-      q->addWidget(widgetWrapper->GetWrapped());
+      q->addWidget(widget);
     }
   }
   else {
@@ -114,7 +115,7 @@ NAN_METHOD(QBoxLayoutWrap::AddLayout) {
   QBoxLayoutWrap* w = node::ObjectWrap::Unwrap<QBoxLayoutWrap>(info.This());
   QBoxLayout* q = w->GetWrapped();
 
-  if (info.Length() >= 1 && qt_v8::InstanceOf(info[0], &QBoxLayoutWrap::prototype)) {
+  if (info.Length() >= 1 && qt_v8::HasTag(info[0], &QBoxLayoutWrap::prototype)) {
     QBoxLayoutWrap* widgetWrapper = ObjectWrap::Unwrap<QBoxLayoutWrap>(
         info[0]->ToObject());
 
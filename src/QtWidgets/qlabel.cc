@@ -71,18 +71,16 @@ class QLabelImpl : public QLabel {
 };
 
 
-Nan::Persistent<FunctionTemplate> QLabelWrap::prototype;
-Nan::Persistent<Function> QLabelWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QLabelWrap::prototype;
+qt_v8::PerIsolate<Function> QLabelWrap::constructor;
 
 QLabelWrap::QLabelWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
   if (info.Length() >= 1 && info[0]->IsString()) {
     QString text = qt_v8::ToQString(info[0]->ToString());
     QWidget* parent = NULL;
     
-    if (info.Length() == 2 && qt_v8::InstanceOf(info[1], &QWidgetWrap::prototype)) {
-      QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-          info[1]->ToObject());
-      parent = widgetWrapper->GetWrapped();
+    if (info.Length() == 2) {
+      parent = QWidgetWrapBase::UnwrapWidget(info[1]);
     }
 
     q_ = new QLabelImpl(text, parent, this);
@@ -100,9 +98,9 @@ QLabelWrap::~QLabelWrap() {
 NAN_MODULE_INIT(QLabelWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
-  tpl->Inherit(Nan::New(QWidgetWrap::prototype));
+  tpl->Inherit(QWidgetWrap::prototype.Get());
   tpl->SetClassName(Nan::New("QLabel").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "setText", SetText);
@@ -114,8 +112,12 @@ NAN_MODULE_INIT(QLabelWrap::Initialize) {
 }
 
 NAN_METHOD(QLabelWrap::New) {
+  if (!qt_v8::RequireGuiThread("QLabel"))
+    return;
+
   QLabelWrap* w = new QLabelWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QLabelWrap::SetText) {
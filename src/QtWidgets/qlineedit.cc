@@ -71,16 +71,14 @@ class QLineEditImpl : public QLineEdit {
 };
 
 
-Nan::Persistent<FunctionTemplate> QLineEditWrap::prototype;
-Nan::Persistent<Function> QLineEditWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QLineEditWrap::prototype;
+qt_v8::PerIsolate<Function> QLineEditWrap::constructor;
 
 QLineEditWrap::QLineEditWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
   QWidget* parent = NULL;
   
-  if (info.Length() == 1 && qt_v8::InstanceOf(info[0], &QWidgetWrap::prototype)) {
-    QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-        info[0]->ToObject());
-    parent = widgetWrapper->GetWrapped();
+  if (info.Length() == 1) {
+    parent = QWidgetWrapBase::UnwrapWidget(info[0]);
   }
   
   q_ = new QLineEditImpl(parent, this);
@@ -93,9 +91,9 @@ QLineEditWrap::~QLineEditWrap() {
 NAN_MODULE_INIT(QLineEditWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
-  tpl->Inherit(Nan::New(QWidgetWrap::prototype));
+  tpl->Inherit(QWidgetWrap::prototype.Get());
   tpl->SetClassName(Nan::New("QLineEdit").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "text", Text);
@@ -108,8 +106,12 @@ NAN_MODULE_INIT(QLineEditWrap::Initialize) {
 }
 
 NAN_METHOD(QLineEditWrap::New) {
+  if (!qt_v8::RequireGuiThread("QLineEdit"))
+    return;
+
   QLineEditWrap* w = new QLineEditWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QLineEditWrap::Text) {
@@ -31,18 +31,20 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QLineEdit>
 #include "qwidget.h"
 #include "qwidgetwrapbase.h"
 
 class QLineEditWrap : public QWidgetWrapBase {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QLineEdit* GetWrapped() const { return q_; };
+  QWidget* GetWidget() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QLineEditWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QLineEditWrap();
   static NAN_METHOD(New);
@@ -71,16 +71,14 @@ class QPlainTextEditImpl : public QPlainTextEdit {
 };
 
 
-Nan::Persistent<FunctionTemplate> QPlainTextEditWrap::prototype;
-Nan::Persistent<Function> QPlainTextEditWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPlainTextEditWrap::prototype;
+qt_v8::PerIsolate<Function> QPlainTextEditWrap::constructor;
 
 QPlainTextEditWrap::QPlainTextEditWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
   QWidget* parent = NULL;
   
-  if (info.Length() == 1 && qt_v8::InstanceOf(info[0], &QWidgetWrap::prototype)) {
-    QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-        info[0]->ToObject());
-    parent = widgetWrapper->GetWrapped();
+  if (info.Length() == 1) {
+    parent = QWidgetWrapBase::UnwrapWidget(info[0]);
   }
   
   q_ = new QPlainTextEditImpl(parent, this);
@@ -93,9 +91,9 @@ QPlainTextEditWrap::~QPlainTextEditWrap() {
 NAN_MODULE_INIT(QPlainTextEditWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
-  tpl->Inherit(Nan::New(QWidgetWrap::prototype));
+  tpl->Inherit(QWidgetWrap::prototype.Get());
   tpl->SetClassName(Nan::New("QPlainTextEdit").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "toPlainText", ToPlainText);
@@ -108,8 +106,12 @@ NAN_MODULE_INIT(QPlainTextEditWrap::Initialize) {
 }
 
 NAN_METHOD(QPlainTextEditWrap::New) {
+  if (!qt_v8::RequireGuiThread("QPlainTextEdit"))
+    return;
+
   QPlainTextEditWrap* w = new QPlainTextEditWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QPlainTextEditWrap::ToPlainText) {
@@ -31,18 +31,20 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QPlainTextEdit>
 #include "qwidget.h"
 #include "qwidgetwrapbase.h"
 
 class QPlainTextEditWrap : public QWidgetWrapBase {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QPlainTextEdit* GetWrapped() const { return q_; };
+  QWidget* GetWidget() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QPlainTextEditWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QPlainTextEditWrap();
   static NAN_METHOD(New);
@@ -71,18 +71,16 @@ class QPushButtonImpl : public QPushButton {
 };
 
 
-Nan::Persistent<FunctionTemplate> QPushButtonWrap::prototype;
-Nan::Persistent<Function> QPushButtonWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QPushButtonWrap::prototype;
+qt_v8::PerIsolate<Function> QPushButtonWrap::constructor;
 
 QPushButtonWrap::QPushButtonWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
   if (info.Length() >= 1 && info[0]->IsString()) {
     QString text = qt_v8::ToQString(info[0]->ToString());
     QWidget* parent = NULL;
     
-    if (info.Length() == 2 && qt_v8::InstanceOf(info[1], &QWidgetWrap::prototype)) {
-      QWidgetWrap* widgetWrapper = ObjectWrap::Unwrap<QWidgetWrap>(
-          info[1]->ToObject());
-      parent = widgetWrapper->GetWrapped();
+    if (info.Length() == 2) {
+      parent = QWidgetWrapBase::UnwrapWidget(info[1]);
     }
   
     q_ = new QPushButtonImpl(text, parent, this);
@@ -100,9 +98,9 @@ QPushButtonWrap::~QPushButtonWrap() {
 NAN_MODULE_INIT(QPushButtonWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
-  tpl->Inherit(Nan::New(QWidgetWrap::prototype));
+  tpl->Inherit(QWidgetWrap::prototype.Get());
   tpl->SetClassName(Nan::New("QPushButton").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "setText", SetText);
@@ -114,8 +112,12 @@ NAN_MODULE_INIT(QPushButtonWrap::Initialize) {
 }
 
 NAN_METHOD(QPushButtonWrap::New) {
+  if (!qt_v8::RequireGuiThread("QPushButton"))
+    return;
+
   QPushButtonWrap* w = new QPushButtonWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QPushButtonWrap::SetText) {
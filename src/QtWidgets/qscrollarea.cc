@@ -36,8 +36,8 @@
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QScrollAreaWrap::prototype;
-Nan::Persistent<Function> QScrollAreaWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QScrollAreaWrap::prototype;
+qt_v8::PerIsolate<Function> QScrollAreaWrap::constructor;
 
 // Supported implementations:
 //   QScrollArea ( )
@@ -52,18 +52,12 @@ QScrollAreaWrap::QScrollAreaWrap(Nan::NAN_METHOD_ARGS_TYPE info) {
 
   // QScrollArea ( QWidget widget )
 
-  QString arg0_constructor = 
-      qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
+  QWidget* q = QWidgetWrapBase::UnwrapWidget(info[0]);
 
-  if (arg0_constructor != "QWidget")
+  if (!q)
     Nan::ThrowError(Exception::TypeError(
       Nan::New("QScrollArea::constructor: bad argument").ToLocalChecked()));
 
-  // Unwrap obj
-  QWidgetWrap* q_wrap = ObjectWrap::Unwrap<QWidgetWrap>(
-      info[0]->ToObject());
-  QWidget* q = q_wrap->GetWrapped();
-
   q_ = new QScrollArea(q);
 }
 
@@ -75,7 +69,7 @@ NAN_MODULE_INIT(QScrollAreaWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QScrollArea").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Wrapped methods
   Nan::SetPrototypeMethod(tpl, "resize", Resize);
@@ -108,8 +102,12 @@ NAN_MODULE_INIT(QScrollAreaWrap::Initialize) {
 }
 
 NAN_METHOD(QScrollAreaWrap::New) {
+  if (!qt_v8::RequireGuiThread("QScrollArea"))
+    return;
+
   QScrollAreaWrap* w = new QScrollAreaWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(QScrollAreaWrap::Resize) {
@@ -193,30 +191,19 @@ NAN_METHOD(QScrollAreaWrap::Update) {
   QScrollAreaWrap* w = node::ObjectWrap::Unwrap<QScrollAreaWrap>(info.This());
   QScrollArea* q = w->GetWrapped();
 
-  q->update();
-
-  info.GetReturnValue().Set(Nan::Undefined());
+  QWidgetWrapBase::UpdateWidget(q, info);
 }
 
 NAN_METHOD(QScrollAreaWrap::SetWidget) {
   QScrollAreaWrap* w = node::ObjectWrap::Unwrap<QScrollAreaWrap>(info.This());
   QScrollArea* q = w->GetWrapped();
 
-  QString arg0_constructor;
-  if (info[0]->IsObject()) {
-    arg0_constructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-  }
+  QWidget* widget = QWidgetWrapBase::UnwrapWidget(info[0]);
 
-  if (arg0_constructor != "QWidget")
+  if (!widget)
     return Nan::ThrowError(Exception::TypeError(
       Nan::New("QScrollArea::SetWidget: bad argument").ToLocalChecked()));
 
-  // Unwrap obj
-  QWidgetWrap* widget_wrap = ObjectWrap::Unwrap<QWidgetWrap>(
-      info[0]->ToObject());
-  QWidget* widget = widget_wrap->GetWrapped();
-
   q->setWidget(widget);
 
   info.GetReturnValue().Set(Nan::Undefined());
@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "qscrollbar.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> QScrollBarWrap::prototype;
-Nan::Persistent<Function> QScrollBarWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QScrollBarWrap::prototype;
+qt_v8::PerIsolate<Function> QScrollBarWrap::constructor;
 
 QScrollBarWrap::QScrollBarWrap(Nan::NAN_METHOD_ARGS_TYPE info) : q_(NULL) {
 }
@@ -46,7 +47,7 @@ NAN_MODULE_INIT(QScrollBarWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QScrollBar").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "value", Value);
@@ -59,14 +60,18 @@ NAN_MODULE_INIT(QScrollBarWrap::Initialize) {
 }
 
 NAN_METHOD(QScrollBarWrap::New) {
+  if (!qt_v8::RequireGuiThread("QScrollBar"))
+    return;
+
   QScrollBarWrap* w = new QScrollBarWrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 Handle<Value> QScrollBarWrap::NewInstance(QScrollBar *q) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   QScrollBarWrap* w = node::ObjectWrap::Unwrap<QScrollBarWrap>(instance);
   w->SetWrapped(q);
 
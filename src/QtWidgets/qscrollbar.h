@@ -31,11 +31,12 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QScrollBar>
 
 class QScrollBarWrap : public node::ObjectWrap {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QScrollBar* GetWrapped() const { return q_; };
   void SetWrapped(QScrollBar *q) { 
@@ -46,7 +47,7 @@ class QScrollBarWrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(QScrollBar *q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QScrollBarWrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~QScrollBarWrap();
   static NAN_METHOD(New);
@@ -71,8 +71,8 @@ class QWidgetImpl : public QWidget {
   };
 };
 
-Nan::Persistent<FunctionTemplate> QWidgetWrap::prototype;
-Nan::Persistent<Function> QWidgetWrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> QWidgetWrap::prototype;
+qt_v8::PerIsolate<Function> QWidgetWrap::constructor;
 
 //
 // QWidgetWrap()
@@ -89,7 +89,7 @@ NAN_MODULE_INIT(QWidgetWrap::Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("QWidget").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Wrapped methods
   Nan::SetPrototypeMethod(tpl, "resize", Resize);
@@ -121,15 +121,18 @@ NAN_MODULE_INIT(QWidgetWrap::Initialize) {
 }
 
 NAN_METHOD(QWidgetWrap::New) {
+  if (!qt_v8::RequireGuiThread("QWidget"))
+    return;
+
   QWidget* q_parent = 0;
 
   if (info.Length() > 0) {
-    QWidgetWrap* w_parent = node::ObjectWrap::Unwrap<QWidgetWrap>(info[0]->ToObject());
-    q_parent = w_parent->GetWrapped();
+    q_parent = QWidgetWrapBase::UnwrapWidget(info[0]);
   }
 
   QWidgetWrap* w = new QWidgetWrap(q_parent);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 // Supported implementations:
@@ -142,15 +145,7 @@ NAN_METHOD(QWidgetWrap::Resize) {
   if (info.Length() == 2 && info[0]->IsNumber() && info[1]->IsNumber()) {
     q->resize(info[0]->NumberValue(), info[1]->NumberValue());
   }
-  else if(info.Length() == 1 && info[0]->IsObject()) {
-    QString objectConstructor = 
-        qt_v8::ToQString(info[0]->ToObject()->GetConstructorName());
-    
-    if (objectConstructor != "QSize") {
-      Nan::ThrowError(Exception::TypeError(
-        Nan::New("QWidget::Resize: bad argument").ToLocalChecked()));
-    }
-    
+  else if(info.Length() == 1 && qt_v8::HasTag(info[0], &QSizeWrap::prototype)) {
     QSizeWrap* widgetWrapper = ObjectWrap::Unwrap<QSizeWrap>(
         info[0]->ToObject());
     QSize* size = widgetWrapper->GetWrapped();
@@ -233,13 +228,11 @@ NAN_METHOD(QWidgetWrap::Parent) {
   info.GetReturnValue().Set(qt_v8::FromQString(q->parent()->objectName()));
 }
 
+// Also used by QLabel etc. through the prototype chain, so go through 
+// UnwrapWidget rather than assuming this is a QWidgetWrap
 NAN_METHOD(QWidgetWrap::Update) {
-  QWidgetWrap* w = node::ObjectWrap::Unwrap<QWidgetWrap>(info.This());
-  QWidget* q = w->GetWrapped();
-
-  q->update();
-
-  info.GetReturnValue().Set(Nan::Undefined());
+  QWidgetWrapBase::UpdateWidget(QWidgetWrapBase::UnwrapWidget(info.This()), 
+      info);
 }
 
 NAN_METHOD(QWidgetWrap::HasMouseTracking) {
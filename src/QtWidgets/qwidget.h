@@ -31,6 +31,7 @@
 
 #include <node.h>
 #include <nan.h>
+#include "../qt_v8.h"
 #include <QWidget>
 #include "qwidgetwrapbase.h"
 
@@ -39,12 +40,13 @@
 //
 class QWidgetWrap : public QWidgetWrapBase {
  public:
-  static Nan::Persistent<v8::FunctionTemplate> prototype;
+  static qt_v8::PerIsolate<v8::FunctionTemplate> prototype;
   static NAN_MODULE_INIT(Initialize);
   QWidget* GetWrapped() const { return q_; };
+  QWidget* GetWidget() const { return q_; };
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   QWidgetWrap(QWidget* parent);
   ~QWidgetWrap();
   static NAN_METHOD(New);
@@ -1,17 +1,116 @@
+#include <string.h>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPaintEvent>
+#include <QRegion>
+#include "../qt_v8.h"
 #include "qwidgetwrapbase.h"
+#include "qwidget.h"
+#include "qscrollarea.h"
+#include "framescheduler.h"
 
 using namespace v8;
 
+//
+// Property names of the reused event objects, internalized once per 
+// isolate so every event writes the same keys in the same order
+//
+enum EventKey {
+  kTypeKey, kXKey, kYKey, kGlobalXKey, kGlobalYKey, kButtonKey, kButtonsKey,
+  kKeyKey, kTextKey, kIsAutoRepeatKey, kCountKey, kModifiersKey, 
+  kTimestampKey, kQEventKey, kEventKeyCount
+};
+
+struct EventKeys {
+  EventKeys() {
+    static const char* names[kEventKeyCount] = {
+      "type", "x", "y", "globalX", "globalY", "button", "buttons", 
+      "key", "text", "isAutoRepeat", "count", "modifiers", 
+      "timestamp", "qevent"
+    };
+
+    for (int i = 0; i < kEventKeyCount; i++) {
+      keys[i].Reset(String::NewFromUtf8(Isolate::GetCurrent(), names[i], 
+          NewStringType::kInternalized).ToLocalChecked());
+    }
+  }
+
+  ~EventKeys() {
+    for (int i = 0; i < kEventKeyCount; i++)
+      keys[i].Reset();
+  }
+
+  Local<String> operator[](int i) const { return Nan::New(keys[i]); }
+
+  Nan::Persistent<String> keys[kEventKeyCount];
+};
+
+static qt_v8::IsolateData<EventKeys> event_keys;
+
+// Milliseconds; Qt 4 events carry no timestamp, so it's the time of 
+// delivery there
+static double Timestamp(QInputEvent* e) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+  return e->timestamp();
+#else
+  Q_UNUSED(e);
+  static QElapsedTimer clock;
+  if (!clock.isValid())
+    clock.start();
+  return clock.elapsed();
+#endif
+}
+
+static Local<Value> Field(Local<Object> object, const EventKeys& keys, 
+    EventKey key) {
+  return Nan::Get(object, keys[key]).ToLocalChecked();
+}
+
+static QEvent::Type FlushMovesEventType() {
+  static int type = QEvent::registerEventType();
+  return static_cast<QEvent::Type>(type);
+}
+
+//
+// MoveFlusher
+// Target of the event posted after the first coalesced mouse move. Posted 
+// events are handled after the input already queued, so every move of a 
+// burst reaches JS in a single call.
+//
+class MoveFlusher : public QObject {
+ public:
+  explicit MoveFlusher(QWidgetWrapBase* wrapper) : wrapper_(wrapper) {}
+
+ protected:
+  void customEvent(QEvent* e) {
+    if (e->type() == FlushMovesEventType())
+      wrapper_->FlushMouseMoves();
+  }
+
+ private:
+  QWidgetWrapBase* wrapper_;
+};
+
 //
 // QWidgetWrapBase()
 //
+QWidgetWrapBase::QWidgetWrapBase()
+    : mousePressMode(kWrapperEvents), mouseReleaseMode(kWrapperEvents), 
+      mouseMoveMode(kWrapperEvents), keyPressMode(kWrapperEvents), 
+      keyReleaseMode(kWrapperEvents), coalesceMouseMoves(false), 
+      moveFlusher(new MoveFlusher(this)) {
+}
+
 QWidgetWrapBase::~QWidgetWrapBase() {
-  delete &paintEventCallback;
-  delete &mousePressCallback;
-  delete &mouseReleaseCallback;
-  delete &mouseMoveCallback;
-  delete &keyPressCallback;
-  delete &keyReleaseCallback;
+  paintEventCallback.Reset();
+  mousePressCallback.Reset();
+  mouseReleaseCallback.Reset();
+  mouseMoveCallback.Reset();
+  keyPressCallback.Reset();
+  keyReleaseCallback.Reset();
+  mouseEventObject.Reset();
+  keyEventObject.Reset();
+  delete moveFlusher; // drops its pending flush event
 }
 
 void QWidgetWrapBase::Inherit(Local<FunctionTemplate> tpl) {
@@ -23,6 +122,55 @@ void QWidgetWrapBase::Inherit(Local<FunctionTemplate> tpl) {
   Nan::SetPrototypeMethod(tpl, "keyReleaseEvent", KeyReleaseEvent);
 }
 
+QWidget* QWidgetWrapBase::UnwrapWidget(Local<Value> value) {
+  if (qt_v8::InstanceOf(value, &QWidgetWrap::prototype)) {
+    return node::ObjectWrap::Unwrap<QWidgetWrapBase>(
+        value->ToObject())->GetWidget();
+  }
+
+  if (qt_v8::HasTag(value, &QScrollAreaWrap::prototype)) {
+    return node::ObjectWrap::Unwrap<QScrollAreaWrap>(
+        value->ToObject())->GetWrapped();
+  }
+
+  return NULL;
+}
+
+void QWidgetWrapBase::UpdateWidget(QWidget* widget, 
+    Nan::NAN_METHOD_ARGS_TYPE info) {
+  if (info.Length() == 0) {
+    // Whole widget: Qt's plain update() unless the frame scheduler takes it
+    if (!FrameScheduler::QueueUpdate(widget, widget->rect()))
+      widget->update();
+
+    info.GetReturnValue().Set(Nan::Undefined());
+    return;
+  }
+
+  QRegion region;
+
+  if (info.Length() == 4 && info[0]->IsNumber() && 
+      info[1]->IsNumber() && info[2]->IsNumber() && info[3]->IsNumber()) {
+    region = QRect(info[0]->Int32Value(), info[1]->Int32Value(), 
+        info[2]->Int32Value(), info[3]->Int32Value());
+  } else if (info.Length() == 1 && info[0]->IsInt32Array()) {
+    Nan::TypedArrayContents<int32_t> rects(info[0]);
+
+    for (size_t i = 0; i + 3 < rects.length(); i += 4)
+      region += QRect((*rects)[i], (*rects)[i + 1], (*rects)[i + 2], 
+          (*rects)[i + 3]);
+  } else {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::Update: bad arguments").ToLocalChecked()));
+  }
+
+  // With frame aligned updates the repaint waits for the next frame
+  if (!FrameScheduler::QueueUpdate(widget, region))
+    widget->update(region);
+
+  info.GetReturnValue().Set(Nan::Undefined());
+}
+
 //
 // PaintEvent()
 // Binds a callback to Qt's event
@@ -37,6 +185,46 @@ NAN_METHOD(QWidgetWrapBase::PaintEvent) {
   info.GetReturnValue().Set(Nan::Undefined());
 }
 
+// Supported options of the mouse and key event binders:
+//   mode   'wrapper'  a QMouseEvent/QKeyEvent per event (default)
+//          'object'   a plain object reused for every event of the widget,
+//                     valid only during the callback. Mouse events have 
+//                     type, x, y, globalX, globalY, button, buttons, 
+//                     modifiers and timestamp; key events have type, key, 
+//                     text, isAutoRepeat, count, modifiers and timestamp. 
+//                     qevent() builds the full wrapper on demand.
+//          'args'     callback(x, y, buttons, modifiers, timestamp, button)
+//                     for mouse events, callback(key, modifiers, timestamp,
+//                     text, isAutoRepeat) for key events
+bool QWidgetWrapBase::BindEvent(Nan::NAN_METHOD_ARGS_TYPE info, 
+    Nan::Persistent<Function>* callback, EventMode* mode) {
+  EventMode new_mode = kWrapperEvents;
+
+  if (info[1]->IsObject()) {
+    Local<Value> value = Nan::Get(info[1]->ToObject(), 
+        Nan::New("mode").ToLocalChecked()).ToLocalChecked();
+
+    if (!value->IsUndefined()) {
+      QString name = value->IsString() ? 
+          qt_v8::ToQString(value->ToString()) : QString();
+
+      if (name == "object")
+        new_mode = kObjectEvents;
+      else if (name == "args")
+        new_mode = kArgsEvents;
+      else if (name != "wrapper")
+        return false;
+    }
+  }
+
+  if (info[0]->IsFunction()) {
+    callback->Reset(Local<Function>::Cast(info[0]));
+    *mode = new_mode;
+  }
+
+  return true;
+}
+
 //
 // MousePressEvent()
 // Binds a callback to Qt's event
@@ -44,8 +232,9 @@ NAN_METHOD(QWidgetWrapBase::PaintEvent) {
 NAN_METHOD(QWidgetWrapBase::MousePressEvent) {
   QWidgetWrapBase* w = node::ObjectWrap::Unwrap<QWidgetWrapBase>(info.This());
 
-  if (info[0]->IsFunction()) {
-    w->mousePressCallback.Reset(Local<Function>::Cast(info[0]));
+  if (!BindEvent(info, &w->mousePressCallback, &w->mousePressMode)) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::MousePressEvent: bad mode").ToLocalChecked()));
   }
 
   info.GetReturnValue().Set(Nan::Undefined());
@@ -58,8 +247,9 @@ NAN_METHOD(QWidgetWrapBase::MousePressEvent) {
 NAN_METHOD(QWidgetWrapBase::MouseReleaseEvent) {
   QWidgetWrapBase* w = node::ObjectWrap::Unwrap<QWidgetWrapBase>(info.This());
 
-  if (info[0]->IsFunction()) {
-    w->mouseReleaseCallback.Reset(Local<Function>::Cast(info[0]));
+  if (!BindEvent(info, &w->mouseReleaseCallback, &w->mouseReleaseMode)) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::MouseReleaseEvent: bad mode").ToLocalChecked()));
   }
 
   info.GetReturnValue().Set(Nan::Undefined());
@@ -67,13 +257,25 @@ NAN_METHOD(QWidgetWrapBase::MouseReleaseEvent) {
 
 //
 // MouseMoveEvent()
-// Binds a callback to Qt's event
+// Binds a callback to Qt's event. Besides mode, takes the option
+//   coalesce   true to get callback(x, y, points, buttons, modifiers) at 
+//              most once per event loop pass, with the latest position and
+//              a Float64Array of [x, y, timestamp, ...] for every move 
+//              since the last call, oldest first. mode is ignored.
 //
 NAN_METHOD(QWidgetWrapBase::MouseMoveEvent) {
   QWidgetWrapBase* w = node::ObjectWrap::Unwrap<QWidgetWrapBase>(info.This());
 
+  if (!BindEvent(info, &w->mouseMoveCallback, &w->mouseMoveMode)) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::MouseMoveEvent: bad mode").ToLocalChecked()));
+  }
+
   if (info[0]->IsFunction()) {
-    w->mouseMoveCallback.Reset(Local<Function>::Cast(info[0]));
+    w->coalesceMouseMoves = info[1]->IsObject() && Nan::Get(
+        info[1]->ToObject(), Nan::New("coalesce").ToLocalChecked())
+        .ToLocalChecked()->BooleanValue();
+    w->pendingMoves.clear();
   }
 
   info.GetReturnValue().Set(Nan::Undefined());
@@ -86,8 +288,9 @@ NAN_METHOD(QWidgetWrapBase::MouseMoveEvent) {
 NAN_METHOD(QWidgetWrapBase::KeyPressEvent) {
   QWidgetWrapBase* w = node::ObjectWrap::Unwrap<QWidgetWrapBase>(info.This());
 
-  if (info[0]->IsFunction()) {
-    w->keyPressCallback.Reset(Local<Function>::Cast(info[0]));
+  if (!BindEvent(info, &w->keyPressCallback, &w->keyPressMode)) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::KeyPressEvent: bad mode").ToLocalChecked()));
   }
 
   info.GetReturnValue().Set(Nan::Undefined());
@@ -100,20 +303,52 @@ NAN_METHOD(QWidgetWrapBase::KeyPressEvent) {
 NAN_METHOD(QWidgetWrapBase::KeyReleaseEvent) {
   QWidgetWrapBase* w = node::ObjectWrap::Unwrap<QWidgetWrapBase>(info.This());
 
-  if (info[0]->IsFunction()) {
-    w->keyReleaseCallback.Reset(Local<Function>::Cast(info[0]));
+  if (!BindEvent(info, &w->keyReleaseCallback, &w->keyReleaseMode)) {
+    return Nan::ThrowError(Exception::TypeError(
+        Nan::New("QWidget::KeyReleaseEvent: bad mode").ToLocalChecked()));
   }
 
   info.GetReturnValue().Set(Nan::Undefined());
 }
 
+static void PutRect(int32_t* out, const QRect& rect) {
+  out[0] = rect.x();
+  out[1] = rect.y();
+  out[2] = rect.width();
+  out[3] = rect.height();
+}
+
+// The callback gets the damaged region as an Int32Array of 
+// [x, y, width, height, ...] rects
 void QWidgetWrapBase::paintEvent(QPaintEvent* e) {
   if (paintEventCallback.IsEmpty()) {
     return;
   }
 
-  const unsigned argc = 0;
-  Handle<Value> argv[1] = {};
+  const QRegion& region = e->region();
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(Isolate::GetCurrent(), 
+      region.rectCount() * 4 * sizeof(int32_t));
+  Local<Int32Array> damage = Int32Array::New(buffer, 0, 
+      region.rectCount() * 4);
+
+  Nan::TypedArrayContents<int32_t> contents(damage);
+  int32_t* out = *contents;
+
+  // QRegion::rects() is deprecated from Qt 5.8 on
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+  for (QRegion::const_iterator it = region.begin(); it != region.end(); 
+      ++it, out += 4)
+    PutRect(out, *it);
+#else
+  QVector<QRect> rects = region.rects();
+  for (int i = 0; i < rects.size(); i++, out += 4)
+    PutRect(out, rects[i]);
+#endif
+
+  const unsigned argc = 1;
+  Handle<Value> argv[argc] = {
+    damage
+  };
 
   Nan::Callback(Nan::New(paintEventCallback)).Call(argc, argv);
 }
@@ -121,31 +356,27 @@ void QWidgetWrapBase::paintEvent(QPaintEvent* e) {
 void QWidgetWrapBase::mousePressEvent(QMouseEvent* e) {
   e->ignore(); // ensures event bubbles up
 
+  // Moves that came before the click are delivered before it
+  FlushMouseMoves();
+
   if (mousePressCallback.IsEmpty()) {
     return;
   }
 
-  const unsigned argc = 1;
-  Handle<Value> argv[argc] = {
-    QMouseEventWrap::NewInstance(*e)
-  };
-
-  Nan::Callback(Nan::New(mousePressCallback)).Call(argc, argv);
+  DispatchMouseEvent(e, mousePressCallback, mousePressMode);
 }
 
 void QWidgetWrapBase::mouseReleaseEvent(QMouseEvent* e) {
   e->ignore(); // ensures event bubbles up
 
+  // Moves that came before the click are delivered before it
+  FlushMouseMoves();
+
   if (mouseReleaseCallback.IsEmpty()) {
     return;
   }
 
-  const unsigned argc = 1;
-  Handle<Value> argv[argc] = {
-    QMouseEventWrap::NewInstance(*e)
-  };
-
-  Nan::Callback(Nan::New(mouseReleaseCallback)).Call(argc, argv);
+  DispatchMouseEvent(e, mouseReleaseCallback, mouseReleaseMode);
 }
 
 void QWidgetWrapBase::mouseMoveEvent(QMouseEvent* e) {
@@ -155,12 +386,18 @@ void QWidgetWrapBase::mouseMoveEvent(QMouseEvent* e) {
     return;
   }
 
-  const unsigned argc = 1;
-  Handle<Value> argv[argc] = {
-    QMouseEventWrap::NewInstance(*e)
-  };
+  if (coalesceMouseMoves) {
+    if (pendingMoves.isEmpty())
+      QCoreApplication::postEvent(moveFlusher, 
+          new QEvent(FlushMovesEventType()));
 
-  Nan::Callback(Nan::New(mouseMoveCallback)).Call(argc, argv);
+    pendingMoves << e->x() << e->y() << Timestamp(e);
+    pendingButtons = e->buttons();
+    pendingModifiers = e->modifiers();
+    return;
+  }
+
+  DispatchMouseEvent(e, mouseMoveCallback, mouseMoveMode);
 }
 
 void QWidgetWrapBase::keyPressEvent(QKeyEvent* e) {
@@ -170,12 +407,7 @@ void QWidgetWrapBase::keyPressEvent(QKeyEvent* e) {
     return;
   }
 
-  const unsigned argc = 1;
-  Handle<Value> argv[argc] = {
-    QKeyEventWrap::NewInstance(*e)
-  };
-
-  Nan::Callback(Nan::New(keyPressCallback)).Call(argc, argv);
+  DispatchKeyEvent(e, keyPressCallback, keyPressMode);
 }
 
 void QWidgetWrapBase::keyReleaseEvent(QKeyEvent* e) {
@@ -185,10 +417,176 @@ void QWidgetWrapBase::keyReleaseEvent(QKeyEvent* e) {
     return;
   }
 
-  const unsigned argc = 1;
-  Handle<Value> argv[argc] = {
-    QKeyEventWrap::NewInstance(*e)
+  DispatchKeyEvent(e, keyReleaseCallback, keyReleaseMode);
+}
+
+void QWidgetWrapBase::DispatchMouseEvent(QMouseEvent* e, 
+    const Nan::Persistent<Function>& callback, EventMode mode) {
+  Nan::HandleScope scope;
+  Nan::Callback handler(Nan::New(callback));
+
+  if (mode == kArgsEvents) {
+    Local<Value> argv[] = {
+      Nan::New(e->x()),
+      Nan::New(e->y()),
+      Nan::New(static_cast<int>(e->buttons())),
+      Nan::New(static_cast<int>(e->modifiers())),
+      Nan::New(Timestamp(e)),
+      Nan::New(static_cast<int>(e->button()))
+    };
+    handler.Call(6, argv);
+    return;
+  }
+
+  if (mode == kWrapperEvents) {
+    Local<Value> argv[] = { QMouseEventWrap::NewInstance(*e) };
+    handler.Call(1, argv);
+    return;
+  }
+
+  const EventKeys& keys = *event_keys.Get();
+  Local<Object> object;
+
+  if (mouseEventObject.IsEmpty()) {
+    object = Nan::New<Object>();
+    Nan::Set(object, keys[kQEventKey], Nan::GetFunction(
+        Nan::New<FunctionTemplate>(MouseQEvent)).ToLocalChecked());
+    mouseEventObject.Reset(object);
+  } else {
+    object = Nan::New(mouseEventObject);
+  }
+
+  Nan::Set(object, keys[kTypeKey], Nan::New(static_cast<int>(e->type())));
+  Nan::Set(object, keys[kXKey], Nan::New(e->x()));
+  Nan::Set(object, keys[kYKey], Nan::New(e->y()));
+  Nan::Set(object, keys[kGlobalXKey], Nan::New(e->globalX()));
+  Nan::Set(object, keys[kGlobalYKey], Nan::New(e->globalY()));
+  Nan::Set(object, keys[kButtonKey], 
+      Nan::New(static_cast<int>(e->button())));
+  Nan::Set(object, keys[kButtonsKey], 
+      Nan::New(static_cast<int>(e->buttons())));
+  Nan::Set(object, keys[kModifiersKey], 
+      Nan::New(static_cast<int>(e->modifiers())));
+  Nan::Set(object, keys[kTimestampKey], Nan::New(Timestamp(e)));
+
+  Local<Value> argv[] = { object };
+  handler.Call(1, argv);
+}
+
+void QWidgetWrapBase::DispatchKeyEvent(QKeyEvent* e, 
+    const Nan::Persistent<Function>& callback, EventMode mode) {
+  Nan::HandleScope scope;
+  Nan::Callback handler(Nan::New(callback));
+
+  if (mode == kArgsEvents) {
+    Local<Value> argv[] = {
+      Nan::New(e->key()),
+      Nan::New(static_cast<int>(e->modifiers())),
+      Nan::New(Timestamp(e)),
+      qt_v8::FromQString(e->text()),
+      Nan::New(e->isAutoRepeat())
+    };
+    handler.Call(5, argv);
+    return;
+  }
+
+  if (mode == kWrapperEvents) {
+    Local<Value> argv[] = { QKeyEventWrap::NewInstance(*e) };
+    handler.Call(1, argv);
+    return;
+  }
+
+  const EventKeys& keys = *event_keys.Get();
+  Local<Object> object;
+
+  if (keyEventObject.IsEmpty()) {
+    object = Nan::New<Object>();
+    Nan::Set(object, keys[kQEventKey], Nan::GetFunction(
+        Nan::New<FunctionTemplate>(KeyQEvent)).ToLocalChecked());
+    keyEventObject.Reset(object);
+  } else {
+    object = Nan::New(keyEventObject);
+  }
+
+  Nan::Set(object, keys[kTypeKey], Nan::New(static_cast<int>(e->type())));
+  Nan::Set(object, keys[kKeyKey], Nan::New(e->key()));
+  Nan::Set(object, keys[kTextKey], qt_v8::FromQString(e->text()));
+  Nan::Set(object, keys[kIsAutoRepeatKey], Nan::New(e->isAutoRepeat()));
+  Nan::Set(object, keys[kCountKey], Nan::New(e->count()));
+  Nan::Set(object, keys[kModifiersKey], 
+      Nan::New(static_cast<int>(e->modifiers())));
+  Nan::Set(object, keys[kTimestampKey], Nan::New(Timestamp(e)));
+
+  Local<Value> argv[] = { object };
+  handler.Call(1, argv);
+}
+
+void QWidgetWrapBase::FlushMouseMoves() {
+  if (pendingMoves.isEmpty())
+    return;
+
+  Nan::HandleScope scope;
+
+  int count = pendingMoves.size();
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(Isolate::GetCurrent(), 
+      count * sizeof(double));
+  Local<Float64Array> points = Float64Array::New(buffer, 0, count);
+
+  Nan::TypedArrayContents<double> contents(points);
+  memcpy(*contents, pendingMoves.constData(), count * sizeof(double));
+
+  Local<Value> argv[] = {
+    Nan::New(pendingMoves[count - 3]),
+    Nan::New(pendingMoves[count - 2]),
+    points,
+    Nan::New(static_cast<int>(pendingButtons)),
+    Nan::New(static_cast<int>(pendingModifiers))
   };
 
-  Nan::Callback(Nan::New(keyReleaseCallback)).Call(argc, argv);
-}
\ No newline at end of file
+  // Cleared first: the callback may process events and queue new moves
+  pendingMoves.clear();
+
+  if (!mouseMoveCallback.IsEmpty())
+    Nan::Callback(Nan::New(mouseMoveCallback)).Call(5, argv);
+}
+
+//
+// MouseQEvent(), KeyQEvent()
+// qevent() of the reused event objects. Rebuilds the Qt event from the 
+// object's current fields, so it must be called during the callback.
+//
+NAN_METHOD(QWidgetWrapBase::MouseQEvent) {
+  const EventKeys& keys = *event_keys.Get();
+  Local<Object> object = info.This();
+
+  QMouseEvent e(
+      static_cast<QEvent::Type>(Field(object, keys, kTypeKey)->Int32Value()),
+      QPoint(Field(object, keys, kXKey)->Int32Value(), 
+          Field(object, keys, kYKey)->Int32Value()),
+      QPoint(Field(object, keys, kGlobalXKey)->Int32Value(), 
+          Field(object, keys, kGlobalYKey)->Int32Value()),
+      static_cast<Qt::MouseButton>(
+          Field(object, keys, kButtonKey)->Int32Value()),
+      static_cast<Qt::MouseButtons>(
+          Field(object, keys, kButtonsKey)->Int32Value()),
+      static_cast<Qt::KeyboardModifiers>(
+          Field(object, keys, kModifiersKey)->Int32Value()));
+
+  info.GetReturnValue().Set(QMouseEventWrap::NewInstance(e));
+}
+
+NAN_METHOD(QWidgetWrapBase::KeyQEvent) {
+  const EventKeys& keys = *event_keys.Get();
+  Local<Object> object = info.This();
+
+  QKeyEvent e(
+      static_cast<QEvent::Type>(Field(object, keys, kTypeKey)->Int32Value()),
+      Field(object, keys, kKeyKey)->Int32Value(),
+      static_cast<Qt::KeyboardModifiers>(
+          Field(object, keys, kModifiersKey)->Int32Value()),
+      qt_v8::ToQString(Field(object, keys, kTextKey)->ToString()),
+      Field(object, keys, kIsAutoRepeatKey)->BooleanValue(),
+      static_cast<ushort>(Field(object, keys, kCountKey)->Int32Value()));
+
+  info.GetReturnValue().Set(QKeyEventWrap::NewInstance(e));
+}
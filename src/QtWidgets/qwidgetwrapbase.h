@@ -2,14 +2,36 @@
 
 #include <node.h>
 #include <nan.h>
+#include <QVector>
+#include <QWidget>
 #include "../QtGui/qmouseevent.h"
 #include "../QtGui/qkeyevent.h"
 
 class QWidgetWrapBase : public node::ObjectWrap {
  public:
+  // How mouse and key events reach their callbacks, chosen per handler 
+  // with e.g. mouseMoveEvent(callback, { mode: 'args' })
+  enum EventMode {
+    kWrapperEvents,  // a new QMouseEvent/QKeyEvent wrapper per event
+    kObjectEvents,   // one plain object per widget, overwritten per event
+    kArgsEvents      // the event's fields as arguments
+  };
+
+  QWidgetWrapBase();
   ~QWidgetWrapBase();
   
   static void Inherit(v8::Local<v8::FunctionTemplate> tpl);
+
+  // Returns the QWidget behind any wrapped widget (QWidget, its JS 
+  // subclasses and QScrollArea), or NULL if value is not one
+  static QWidget* UnwrapWidget(v8::Local<v8::Value> value);
+  virtual QWidget* GetWidget() const = 0;
+
+  // Backs update() on every widget wrapper:
+  //   update ( )
+  //   update ( int x, int y, int width, int height )
+  //   update ( Int32Array rects )  -- [x, y, width, height, ...]
+  static void UpdateWidget(QWidget* widget, Nan::NAN_METHOD_ARGS_TYPE info);
   
   void paintEvent(QPaintEvent* e);
   void mousePressEvent(QMouseEvent* e);
@@ -17,6 +39,9 @@ class QWidgetWrapBase : public node::ObjectWrap {
   void mouseMoveEvent(QMouseEvent* e);
   void keyPressEvent(QKeyEvent* e);
   void keyReleaseEvent(QKeyEvent* e);
+
+  // Delivers the mouse moves accumulated in coalescing mode as one call
+  void FlushMouseMoves();
   
  private:
   Nan::Persistent<v8::Function> paintEventCallback;
@@ -25,6 +50,35 @@ class QWidgetWrapBase : public node::ObjectWrap {
   Nan::Persistent<v8::Function> mouseMoveCallback;
   Nan::Persistent<v8::Function> keyPressCallback;
   Nan::Persistent<v8::Function> keyReleaseCallback;
+
+  EventMode mousePressMode;
+  EventMode mouseReleaseMode;
+  EventMode mouseMoveMode;
+  EventMode keyPressMode;
+  EventMode keyReleaseMode;
+
+  // mouseMoveEvent(callback, { coalesce: true }) accumulates moves here as
+  // [x, y, timestamp, ...] until a posted event flushes them
+  bool coalesceMouseMoves;
+  QVector<double> pendingMoves;
+  Qt::MouseButtons pendingButtons;
+  Qt::KeyboardModifiers pendingModifiers;
+  QObject* moveFlusher;
+
+  // Reused by handlers in kObjectEvents mode, created on first use
+  Nan::Persistent<v8::Object> mouseEventObject;
+  Nan::Persistent<v8::Object> keyEventObject;
+
+  static bool BindEvent(Nan::NAN_METHOD_ARGS_TYPE info, 
+      Nan::Persistent<v8::Function>* callback, EventMode* mode);
+  void DispatchMouseEvent(QMouseEvent* e, 
+      const Nan::Persistent<v8::Function>& callback, EventMode mode);
+  void DispatchKeyEvent(QKeyEvent* e, 
+      const Nan::Persistent<v8::Function>& callback, EventMode mode);
+
+  // qevent() of the reused objects; builds a wrapper from their fields
+  static NAN_METHOD(MouseQEvent);
+  static NAN_METHOD(KeyQEvent);
   
   // QUIRK
   // Event binding. These functions bind implemented event handlers above
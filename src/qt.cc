@@ -27,6 +27,8 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "qt_v8.h"
+
 #include "QtCore/qsize.h"
 #include "QtCore/qpointf.h"
 
@@ -39,8 +41,14 @@
 #include "QtGui/qpen.h"
 #include "QtGui/qimage.h"
 #include "QtGui/qpainterpath.h"
+#include "QtGui/qpainterpathstroker.h"
 #include "QtGui/qfont.h"
 #include "QtGui/qmatrix.h"
+#include "QtGui/qtransform.h"
+#include "QtGui/qpicture.h"
+#include "QtGui/qstatictext.h"
+#include "QtGui/qpixmapcache.h"
+#include "QtGui/imagecompare.h"
 
 #include "QtWidgets/qapplication.h"
 #include "QtWidgets/qwidget.h"
@@ -51,6 +59,7 @@
 #include "QtWidgets/qlineedit.h"
 #include "QtWidgets/qboxlayout.h"
 #include "QtWidgets/qplaintextedit.h"
+#include "QtWidgets/framescheduler.h"
 
 #include "QtMultimedia/qsound.h"
 
@@ -58,7 +67,11 @@
 
 using namespace v8;
 
+// Runs once per isolate that loads the addon: the main thread and each
+// worker_threads Worker get their own templates and constructors
 void Initialize(Handle<Object> target) {
+  qt_v8::InitializeIsolate(target->GetIsolate());
+
   QApplicationWrap::Initialize(target);
   QWidgetWrap::Initialize(target);
   QSizeWrap::Initialize(target);
@@ -73,8 +86,14 @@ void Initialize(Handle<Object> target) {
   QImageWrap::Initialize(target);
   QPointFWrap::Initialize(target);
   QPainterPathWrap::Initialize(target);
+  QPainterPathStrokerWrap::Initialize(target);
   QFontWrap::Initialize(target);
   QMatrixWrap::Initialize(target);
+  QTransformWrap::Initialize(target);
+  QPictureWrap::Initialize(target);
+  QStaticTextWrap::Initialize(target);
+  QPixmapCacheWrap::Initialize(target);
+  ImageCompare::Initialize(target);
   QSoundWrap::Initialize(target);
   QScrollAreaWrap::Initialize(target);
   QScrollBarWrap::Initialize(target);
@@ -83,6 +102,7 @@ void Initialize(Handle<Object> target) {
   QLineEditWrap::Initialize(target);
   QBoxLayoutWrap::Initialize(target);
   QPlainTextEditWrap::Initialize(target);
+  FrameScheduler::Initialize(target);
 }
 
-NODE_MODULE(qt, Initialize)
+NAN_MODULE_WORKER_ENABLED(qt, Initialize)
@@ -0,0 +1,111 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+namespace qt_parallel {
+
+//
+// Job
+// Work made of independent items 0..count-1. Run() is called on pool 
+// threads; Done() is called on the thread that started the job, in 
+// completion order, so it may call back into JS.
+//
+class Job {
+ public:
+  virtual ~Job() {}
+  virtual void Run(int index) = 0;
+  virtual void Done(int index) {}
+};
+
+class Completion {
+ public:
+  QMutex mutex;
+  QWaitCondition finished_one;
+  QQueue<int> finished;
+};
+
+class Task : public QRunnable {
+ public:
+  Task(Job* job, int index, Completion* completion) 
+      : job_(job), index_(index), completion_(completion) {}
+
+  void run() {
+    job_->Run(index_);
+
+    QMutexLocker lock(&completion_->mutex);
+    completion_->finished.enqueue(index_);
+    completion_->finished_one.wakeOne();
+  }
+
+ private:
+  Job* job_;
+  int index_;
+  Completion* completion_;
+};
+
+// Runs every item of job on the global QThreadPool and blocks until all of
+// them have finished.
+inline void Run(Job* job, int count) {
+  Completion completion;
+  QThreadPool* pool = QThreadPool::globalInstance();
+
+  for (int i = 0; i < count; i++)
+    pool->start(new Task(job, i, &completion));
+
+  QMutexLocker lock(&completion.mutex);
+  for (int remaining = count; remaining > 0; remaining--) {
+    while (completion.finished.isEmpty())
+      completion.finished_one.wait(&completion.mutex);
+
+    int index = completion.finished.dequeue();
+
+    lock.unlock();
+    job->Done(index);
+    lock.relock();
+  }
+}
+
+// Runs every item of job on the calling thread, for work that is not 
+// safe on pool threads
+inline void RunHere(Job* job, int count) {
+  for (int i = 0; i < count; i++) {
+    job->Run(i);
+    job->Done(i);
+  }
+}
+
+} // namespace
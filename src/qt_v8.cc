@@ -0,0 +1,92 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <QCoreApplication>
+#include <QFontDatabase>
+#include <QList>
+#include <QThread>
+#include <node_version.h>
+#include "qt_v8.h"
+
+namespace qt_v8 {
+
+// Filled during static initialization, before any isolate exists
+static QList<IsolateLocal*>& Registry() {
+  static QList<IsolateLocal*>* registry = new QList<IsolateLocal*>();
+  return *registry;
+}
+
+IsolateLocal::IsolateLocal() {
+  Registry().append(this);
+}
+
+void IsolateLocal::DisposeAll(v8::Isolate* isolate) {
+  QList<IsolateLocal*>& registry = Registry();
+  for (int i = 0; i < registry.size(); i++)
+    registry[i]->Dispose(isolate);
+}
+
+static void DisposeIsolate(void* isolate) {
+  IsolateLocal::DisposeAll(static_cast<v8::Isolate*>(isolate));
+}
+
+void InitializeIsolate(v8::Isolate* isolate) {
+#if NODE_MAJOR_VERSION > 10 || \
+    (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 2)
+  node::AddEnvironmentCleanupHook(isolate, DisposeIsolate, isolate);
+#else
+  // No workers before Node 10.5; the main isolate lives until exit
+  Q_UNUSED(isolate);
+#endif
+}
+
+bool RequireGuiThread(const char* name) {
+  QCoreApplication* app = QCoreApplication::instance();
+  if (!app || app->thread() == QThread::currentThread())
+    return true;
+
+  Nan::ThrowError(qPrintable(QString(
+      "%1: only available on the thread that created the QApplication")
+      .arg(name)));
+  return false;
+}
+
+bool RequireTextThread(const char* name) {
+  QCoreApplication* app = QCoreApplication::instance();
+  if (!app || app->thread() == QThread::currentThread() || 
+      QFontDatabase::supportsThreadedFontRendering())
+    return true;
+
+  Nan::ThrowError(qPrintable(QString(
+      "%1: text can only be drawn on the thread that created the "
+      "QApplication on this platform").arg(name)));
+  return false;
+}
+
+} // namespace
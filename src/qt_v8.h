@@ -32,6 +32,9 @@
 #include <node.h>
 #include <nan.h>
 #include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 namespace qt_v8 {
 
@@ -43,8 +46,121 @@ inline v8::Local<v8::String> FromQString(QString str) {
   return Nan::New<v8::String>(str.utf16()).ToLocalChecked();
 }
 
-inline bool InstanceOf(v8::Local<v8::Value> value, Nan::Persistent<v8::FunctionTemplate>* prototype) {
-  return value->IsObject() && Nan::New(*prototype)->HasInstance(value);
+//
+// Per-isolate state
+// The addon is context aware: the main thread and every worker_threads 
+// Worker that loads it get their own isolate, and handles can't be shared
+// between isolates. IsolateLocal is the base of statics that keep one 
+// entry per isolate; InitializeIsolate() registers a cleanup hook that 
+// drops the entries of an environment being torn down.
+//
+class IsolateLocal {
+ public:
+  IsolateLocal();
+  virtual ~IsolateLocal() {}
+  virtual void Dispose(v8::Isolate* isolate) = 0;
+
+  static void DisposeAll(v8::Isolate* isolate);
+};
+
+void InitializeIsolate(v8::Isolate* isolate);
+
+// A handle (template, constructor) per isolate. Wrappers keep their 
+// prototype and constructor in static PerIsolate members, whose addresses
+// double as type tags.
+template <typename T>
+class PerIsolate : public IsolateLocal {
+ public:
+  void Reset(v8::Local<T> value) {
+    QMutexLocker lock(&mutex_);
+    Nan::Persistent<T>*& handle = handles_[v8::Isolate::GetCurrent()];
+    if (!handle)
+      handle = new Nan::Persistent<T>();
+    handle->Reset(value);
+  }
+
+  v8::Local<T> Get() const {
+    QMutexLocker lock(&mutex_);
+    Nan::Persistent<T>* handle = handles_.value(v8::Isolate::GetCurrent());
+    return handle ? Nan::New(*handle) : v8::Local<T>();
+  }
+
+  void Dispose(v8::Isolate* isolate) {
+    QMutexLocker lock(&mutex_);
+    Nan::Persistent<T>* handle = handles_.take(isolate);
+    if (handle)
+      handle->Reset();
+    delete handle;
+  }
+
+ private:
+  mutable QMutex mutex_;
+  QHash<v8::Isolate*, Nan::Persistent<T>*> handles_;
+};
+
+// Plain C++ state per isolate, created on first use. Only the owning 
+// isolate's thread touches its T.
+template <typename T>
+class IsolateData : public IsolateLocal {
+ public:
+  T* Get() {
+    QMutexLocker lock(&mutex_);
+    T*& data = data_[v8::Isolate::GetCurrent()];
+    if (!data)
+      data = new T();
+    return data;
+  }
+
+  void Dispose(v8::Isolate* isolate) {
+    T* data;
+    {
+      QMutexLocker lock(&mutex_);
+      data = data_.take(isolate);
+    }
+    delete data;
+  }
+
+ private:
+  QMutex mutex_;
+  QHash<v8::Isolate*, T*> data_;
+};
+
+// Widgets, pixmaps and sounds belong to the thread that created the 
+// QApplication; workers may only use QImage based classes. Throws and 
+// returns false elsewhere.
+bool RequireGuiThread(const char* name);
+
+// Drawing or laying out text off the QApplication thread needs threaded 
+// font rendering (QFontDatabase::supportsThreadedFontRendering()). Throws 
+// and returns false on other threads where the platform lacks it.
+bool RequireTextThread(const char* name);
+
+//
+// Type tags
+// Every wrapper brands its instances with the address of its class' 
+// prototype handle (internal field 1, next to ObjectWrap's field 0), so 
+// checking an argument's exact type is a pointer compare instead of a 
+// constructor name lookup.
+//
+const int kTagField = 1;
+
+inline void SetTag(v8::Local<v8::Object> object, PerIsolate<v8::FunctionTemplate>* prototype) {
+  Nan::SetInternalFieldPointer(object, kTagField, prototype);
+}
+
+inline bool HasTag(v8::Local<v8::Value> value, PerIsolate<v8::FunctionTemplate>* prototype) {
+  if (!value->IsObject())
+    return false;
+
+  v8::Local<v8::Object> object = value.As<v8::Object>();
+  return object->InternalFieldCount() > kTagField &&
+      Nan::GetInternalFieldPointer(object, kTagField) == prototype;
+}
+
+// Like HasTag(), but also matches subclasses (e.g. QLabel for QWidget)
+inline bool InstanceOf(v8::Local<v8::Value> value, PerIsolate<v8::FunctionTemplate>* prototype) {
+  return HasTag(value, prototype) ||
+      (value->IsObject() && prototype->Get()->HasInstance(value));
 }
 
 } // namespace
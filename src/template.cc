@@ -27,12 +27,13 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "../qt_v8.h"
 #include "__template__.h"
 
 using namespace v8;
 
-Nan::Persistent<FunctionTemplate> __Template__Wrap::prototype;
-Nan::Persistent<Function> __Template__Wrap::constructor;
+qt_v8::PerIsolate<FunctionTemplate> __Template__Wrap::prototype;
+qt_v8::PerIsolate<Function> __Template__Wrap::constructor;
 
 // Supported implementations:
 //   __Template__ ( ??? )
@@ -48,7 +49,7 @@ NAN_MODULE_INIT(Initialize) {
   // Prepare constructor template
   Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
   tpl->SetClassName(Nan::New("__Template__").ToLocalChecked());
-  tpl->InstanceTemplate()->SetInternalFieldCount(1);  
+  tpl->InstanceTemplate()->SetInternalFieldCount(2);  
 
   // Prototype
   Nan::SetPrototypeMethod(tpl, "example", Example);
@@ -62,12 +63,13 @@ NAN_MODULE_INIT(Initialize) {
 NAN_METHOD(__Template__Wrap::New) {
   __Template__Wrap* w = new __Template__Wrap(info);
   w->Wrap(info.This());
+  qt_v8::SetTag(info.This(), &prototype);
 }
 
 NAN_METHOD(__Template__Wrap::NewInstance) {
   Nan::EscapableHandleScope scope;
   
-  Local<Object> instance = Nan::NewInstance(Nan::New(constructor), 0, NULL).ToLocalChecked();
+  Local<Object> instance = Nan::NewInstance(constructor.Get(), 0, NULL).ToLocalChecked();
   __Template__Wrap* w = node::ObjectWrap::Unwrap<__Template__Wrap>(instance);
   w->SetWrapped(q);
 
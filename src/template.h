@@ -31,6 +31,7 @@
 
 #include <node.h>
 #include <nan.h>
+#include "qt_v8.h"
 #include <__Template__>
 
 class __Template__Wrap : public node::ObjectWrap {
@@ -44,7 +45,7 @@ class __Template__Wrap : public node::ObjectWrap {
   static v8::Handle<v8::Value> NewInstance(__Template__ q);
 
  private:
-  static Nan::Persistent<v8::Function> constructor;
+  static qt_v8::PerIsolate<v8::Function> constructor;
   __Template__Wrap(Nan::NAN_METHOD_ARGS_TYPE info);
   ~__Template__Wrap();
   static NAN_METHOD(New);
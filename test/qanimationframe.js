@@ -0,0 +1,131 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..'),
+    test = require('./test');
+
+var app = new qt.QApplication({ headless: true });
+
+assert.throws(function() { qt.requestAnimationFrame(); }, TypeError);
+assert.throws(function() { qt.setFrameRate(0); }, TypeError);
+assert.throws(function() { qt.setFrameRate('fast'); }, TypeError);
+assert.equal(qt.frameRate(), 60);
+
+qt.setFrameRate(100);
+assert.equal(qt.frameRate(), 100);
+
+var widget = new qt.QWidget();
+widget.resize(100, 100);
+
+var painted = 0;
+widget.paintEvent(function() {
+  painted++;
+});
+widget.show();
+app.processEvents();
+
+function frameCallbacks(done) {
+  // Callbacks run in request order with the frame's timestamp; ones 
+  // requested during a frame wait for the next one
+  var order = [];
+  qt.requestAnimationFrame(function(t) {
+    order.push('a');
+    assert.equal(typeof t, 'number');
+
+    qt.requestAnimationFrame(function(t2) {
+      assert.deepEqual(order, ['a', 'b']);
+      assert.ok(t2 > t);
+      done();
+    });
+  });
+  qt.requestAnimationFrame(function() {
+    order.push('b');
+  });
+
+  var cancelled = qt.requestAnimationFrame(function() {
+    test.fail(new Error('cancelled frame callback ran'));
+  });
+  qt.cancelAnimationFrame(cancelled);
+}
+
+function alignedUpdates(done) {
+  // Many update() calls in a frame: one repaint, after the frame callbacks
+  qt.setFrameAlignedUpdates(true);
+  painted = 0;
+
+  for (var i = 0; i < 10; i++)
+    widget.update();
+  widget.update(0, 0, 5, 5);
+  widget.update(new Int32Array([10, 10, 5, 5, 20, 20, 5, 5]));
+  app.processEvents();
+  assert.equal(painted, 0);
+
+  qt.requestAnimationFrame(function() {
+    assert.equal(painted, 0);
+
+    qt.requestAnimationFrame(function() {
+      assert.equal(painted, 1);
+
+      // Turning alignment off hands pending updates back to Qt
+      widget.update();
+      qt.setFrameAlignedUpdates(false);
+      app.processEvents();
+      assert.equal(painted, 2);
+      done();
+    });
+  });
+}
+
+function droppedFrames(done) {
+  // A 35 ms frame at 100 fps misses at least 2 slots
+  qt.resetFrameStats();
+  qt.requestAnimationFrame(function() {
+    var start = Date.now();
+    while (Date.now() - start < 35) {}
+
+    qt.requestAnimationFrame(function() {
+      var stats = qt.frameStats();
+      assert.equal(stats.fps, 100);
+      assert.equal(stats.frames, 1);
+      assert.ok(stats.dropped >= 2);
+      assert.ok(stats.maxFrameTime >= 35);
+      assert.ok(stats.averageFrameTime > 0);
+      done();
+    });
+  });
+}
+
+frameCallbacks(function() {
+  alignedUpdates(function() {
+    droppedFrames(function() {
+      widget.close();
+    });
+  });
+});
@@ -0,0 +1,89 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..'),
+    test = require('./test');
+
+// Only one QApplication can exist per process, so this file runs headless 
+// throughout: none of it may need DISPLAY or Xvfb
+assert.throws(function() { new qt.QApplication(1); }, TypeError);
+assert.throws(function() { new qt.QApplication({ platform: 1 }); }, 
+    TypeError);
+
+var app = new qt.QApplication({ headless: true });
+
+// Qt 4 has no platform plugins and only supports painting on QImages
+var qt5 = app.platformName() !== '';
+
+// isHeadless(), platformName()
+{
+  assert.equal(app.isHeadless(), true);
+  if (qt5)
+    assert.equal(app.platformName(), 'offscreen');
+}
+
+// QImage painting
+{
+  var image = new qt.QImage(4, 4, qt.QImage.Format.Format_ARGB32);
+  var painter = new qt.QPainter();
+  painter.begin(image);
+  painter.fillRect(0, 0, 2, 4, new qt.QColor(255, 0, 0));
+  painter.end();
+
+  var bits = image.bits();
+  assert.equal(bits.readUInt32LE(0), 0xffff0000);
+  assert.equal(bits.readUInt32LE(3 * 4), 0);
+}
+
+// QPixmap painting
+if (qt5) {
+  var pixmap = new qt.QPixmap(8, 8);
+  pixmap.fill(new qt.QColor(0, 0, 255));
+  var painter = new qt.QPainter();
+  painter.begin(pixmap);
+  painter.fillRect(0, 0, 4, 8, new qt.QColor(0, 255, 0));
+  painter.end();
+
+  var bits = pixmap.toImage()
+      .convertToFormat(qt.QImage.Format.Format_ARGB32).bits();
+  assert.equal(bits.readUInt32LE(0), 0xff00ff00);
+  assert.equal(bits.readUInt32LE(7 * 4), 0xff0000ff);
+}
+
+// Widgets without a window system
+if (qt5) {
+  var widget = new qt.QWidget();
+  widget.resize(120, 80);
+  widget.show();
+  app.processEvents();
+  assert.equal(widget.width(), 120);
+  assert.equal(widget.height(), 80);
+  widget.close();
+}
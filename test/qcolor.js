@@ -69,6 +69,14 @@ var app = new qt.QApplication();
   assert.equal(color2.alpha(), 255);
 }
 
+// Constructor rejects objects that merely share the constructor name
+{
+  function QColor() {}
+  assert.throws(function() {
+    new qt.QColor(new QColor);
+  }, TypeError);
+}
+
 // name()
 {
   var color = new qt.QColor('blue');
@@ -0,0 +1,87 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..'),
+    test = require('./test');
+
+// Qt events dispatched from node's event loop: eventLoop 'libuv'
+assert.throws(function() { 
+  new qt.QApplication({ eventLoop: 'glib' }); 
+}, TypeError);
+
+var app;
+try {
+  app = new qt.QApplication({ headless: true, eventLoop: 'libuv' });
+} catch (e) {
+  // Qt 4 and non-X11 platforms keep Qt's own dispatcher
+  console.log('  skipped: ' + e.message);
+  return;
+}
+
+assert.equal(app.eventLoop(), 'libuv');
+
+var widget = new qt.QWidget();
+widget.resize(50, 50);
+
+var painted = 0;
+widget.paintEvent(function() {
+  painted++;
+});
+
+function waitForPaint(timeout, done) {
+  var start = Date.now();
+  (function poll() {
+    if (painted > 0)
+      return done();
+    if (Date.now() - start > timeout)
+      return test.fail(new Error('no paintEvent from the libuv loop'));
+    setTimeout(poll, 5);
+  })();
+}
+
+// No processEvents() anywhere: show() and update() post events, which wake
+// the dispatcher through a uv async
+widget.show();
+waitForPaint(2000, function() {
+  painted = 0;
+  widget.update();
+
+  waitForPaint(2000, function() {
+    // exec() doesn't block; it only holds the process until quit()
+    var start = Date.now();
+    app.exec();
+    assert.ok(Date.now() - start < 1000);
+
+    setTimeout(function() {
+      widget.close();
+      app.quit(); // nothing else is pending, so node exits
+    }, 10);
+  });
+});
@@ -28,7 +28,8 @@
 // THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 var assert = require('assert'),
-    qt = require('..');
+    qt = require('..'),
+    test = require('./test');
 
 var app = new qt.QApplication();
 
@@ -50,3 +51,527 @@ var app = new qt.QApplication();
   var image = new qt.QImage('BAD-FILE');
   assert.equal(image.isNull(), true);
 }
+
+// Constructor- encoded Buffer
+{
+  var data = require('fs').readFileSync('resources/qimage.png');
+  var image = new qt.QImage(data);
+  assert.equal(image.isNull(), false);
+  assert.equal(image.width(), 100);
+
+  var image = new qt.QImage(data, 'PNG');
+  assert.equal(image.isNull(), false);
+
+  var image = new qt.QImage(new Buffer('not an image'));
+  assert.equal(image.isNull(), true);
+}
+
+// Constructor- raw pixel Buffer aliases the caller's memory
+{
+  var pixels = new Buffer(4 * 4 * 2);
+  pixels.fill(0);
+  var image = new qt.QImage(pixels, 4, 2, 16, 
+      qt.QImage.Format.Format_ARGB32);
+  assert.equal(image.width(), 4);
+  assert.equal(image.height(), 2);
+  assert.equal(image.bytesPerLine(), 16);
+  assert.equal(image.format(), qt.QImage.Format.Format_ARGB32);
+
+  pixels[0] = 0x7f;
+  assert.equal(image.bits()[0], 0x7f);
+}
+
+// Constructor- raw pixel Buffer, bad arguments
+{
+  var pixels = new Buffer(16);
+  assert.throws(function() {
+    new qt.QImage(pixels, 4, 2, 16, qt.QImage.Format.Format_ARGB32);
+  }, TypeError);
+  assert.throws(function() {
+    new qt.QImage(pixels, 4, 1, 16, qt.QImage.Format.Format_Invalid);
+  }, TypeError);
+  assert.throws(function() {
+    new qt.QImage(pixels, 4, 1, 8, qt.QImage.Format.Format_ARGB32);
+  }, TypeError);
+}
+
+// Constructor- size and format, cleared
+{
+  var image = new qt.QImage(5, 3, qt.QImage.Format.Format_RGB888);
+  assert.equal(image.width(), 5);
+  assert.equal(image.height(), 3);
+  assert.equal(image.format(), qt.QImage.Format.Format_RGB888);
+  for (var i = 0; i < image.byteCount(); i++)
+    assert.equal(image.bits()[i], 0);
+
+  assert.throws(function() {
+    new qt.QImage(5, 3, qt.QImage.Format.Format_Invalid);
+  }, TypeError);
+  assert.throws(function() { new qt.QImage(5, 3); }, TypeError);
+}
+
+// convertToFormat(), hasAlphaChannel()
+{
+  var Format = qt.QImage.Format;
+  var pixels = new Buffer([0x10, 0x20, 0x40, 0x80]);
+  var image = new qt.QImage(pixels, 1, 1, 4, Format.Format_ARGB32);
+  assert.equal(image.hasAlphaChannel(), true);
+
+  var premultiplied = image.convertToFormat(Format.Format_ARGB32_Premultiplied);
+  assert.equal(premultiplied.format(), Format.Format_ARGB32_Premultiplied);
+  assert.equal(image.format(), Format.Format_ARGB32);
+  assert.equal(premultiplied.bits()[3], 0x80);
+  assert.equal(premultiplied.bits()[2], 0x20);
+
+  var opaque = image.convertToFormat(Format.Format_RGB32);
+  assert.equal(opaque.hasAlphaChannel(), false);
+  assert.equal(opaque.bits()[3], 0xff);
+
+  assert.throws(function() { image.convertToFormat(); }, TypeError);
+  assert.throws(function() { image.convertToFormat(1000); }, TypeError);
+}
+
+// Metadata
+{
+  var image = new qt.QImage('resources/qimage.png');
+  assert.equal(image.width(), 100);
+  assert.equal(image.height(), 100);
+  assert.notEqual(image.format(), qt.QImage.Format.Format_Invalid);
+  assert.ok(image.bytesPerLine() >= 100);
+  assert.equal(image.byteCount(), image.bytesPerLine() * 100);
+}
+
+// bits() - null image
+{
+  var image = new qt.QImage;
+  assert.equal(image.bits(), null);
+}
+
+// bits() - aliases the image pixels
+{
+  var image = new qt.QImage('resources/qimage.png');
+  var bits = image.bits();
+  assert.equal(bits.length, image.byteCount());
+
+  // Writes through one Buffer are visible through the next
+  bits[0] = 0x12;
+  bits[1] = 0x34;
+  var bits2 = image.bits();
+  assert.equal(bits2[0], 0x12);
+  assert.equal(bits2[1], 0x34);
+}
+
+// bits() - Buffer keeps pixels alive after the image is gone
+{
+  var bits = new qt.QImage('resources/qimage.png').bits();
+  if (global.gc) global.gc();
+  bits.fill(0);
+  assert.equal(bits[bits.length - 1], 0);
+}
+
+// convertToFormat() / QPixmap.fromImage() - results in the same format 
+// own their pixels, even when the image is a view onto a Buffer
+{
+  function fill(pixels, value) {
+    var image = new qt.QImage(pixels, 16, 16, 64, 
+        Format.Format_ARGB32_Premultiplied);
+    pixels.fill(value);
+    return image;
+  }
+
+  var exported = new qt.QImage(16, 16, Format.Format_ARGB32_Premultiplied);
+  exported.bits().fill(0x7f);
+
+  var converted = [
+    exported.convertToFormat(Format.Format_ARGB32_Premultiplied),
+    fill(new Buffer(16 * 16 * 4), 0x7f)
+        .convertToFormat(Format.Format_ARGB32_Premultiplied)
+  ];
+  var pixmap = qt.QPixmap.fromImage(fill(new Buffer(16 * 16 * 4), 0x7f));
+  exported = null;
+
+  // Reuse the freed memory
+  test.gc();
+  for (var i = 0; i < 64; i++)
+    new Buffer(16 * 16 * 4).fill(0);
+
+  converted.push(pixmap.toImage()
+      .convertToFormat(Format.Format_ARGB32_Premultiplied));
+  converted.forEach(function(image) {
+    assert.ok(image.bits().equals(new Buffer(16 * 16 * 4).fill(0x7f)));
+  });
+}
+
+// bits() - painting into the image is visible through an exported Buffer
+{
+  var image = new qt.QImage('resources/qimage.png');
+  var bits = image.bits();
+  var painter = new qt.QPainter();
+
+  assert.equal(painter.begin(image), true);
+  painter.fillRect(0, 0, 1, 1, new qt.QColor(1, 2, 3));
+  painter.end();
+
+  if (image.format() === qt.QImage.Format.Format_RGB32) {
+    // 0xffRRGGBB, little-endian
+    assert.equal(bits[0], 3);
+    assert.equal(bits[1], 2);
+    assert.equal(bits[2], 1);
+  }
+}
+
+//
+// Scaling and transforms
+//
+
+var Format = qt.QImage.Format;
+
+// A width x height image of 32-bit pixels, each one color(x, y)
+function makeImage(width, height, format, color) {
+  var pixels = new Buffer(width * height * 4);
+  for (var y = 0; y < height; y++)
+    for (var x = 0; x < width; x++)
+      pixels.writeUInt32LE(color(x, y) >>> 0, (y * width + x) * 4);
+  return new qt.QImage(pixels, width, height, width * 4, format);
+}
+
+function pixel(image, x, y) {
+  return image.bits().readUInt32LE(y * image.bytesPerLine() + x * 4);
+}
+
+// scaled() - fast is nearest neighbour
+{
+  var colors = [0xffff0000, 0xff00ff00, 0xff0000ff, 0xffffffff];
+  var image = makeImage(2, 2, Format.Format_RGB32, function(x, y) {
+    return colors[y * 2 + x];
+  });
+
+  var scaled = image.scaled(4, 4);
+  assert.equal(scaled.width(), 4);
+  assert.equal(scaled.height(), 4);
+  assert.equal(scaled.format(), Format.Format_RGB32);
+  assert.equal(pixel(scaled, 0, 0), colors[0]);
+  assert.equal(pixel(scaled, 3, 1), colors[1]);
+  assert.equal(pixel(scaled, 1, 2), colors[2]);
+  assert.equal(pixel(scaled, 3, 3), colors[3]);
+  assert.ok(image.scaled(4, 4, { mode: 'fast' }).bits().equals(scaled.bits()));
+}
+
+// scaled() / transformed() - fast copies semi-transparent ARGB32 pixels 
+// exactly, without a trip through premultiplied
+{
+  var image = makeImage(2, 2, Format.Format_ARGB32, function() {
+    return 0x80fe0000;
+  });
+
+  var scaled = image.scaled(3, 3);
+  assert.equal(scaled.format(), Format.Format_ARGB32);
+  assert.equal(pixel(scaled, 1, 1), 0x80fe0000);
+
+  var rotated = image.transformed(new qt.QTransform().rotate(90));
+  assert.equal(rotated.format(), Format.Format_ARGB32);
+  assert.equal(pixel(rotated, 0, 0), 0x80fe0000);
+}
+
+// scaled() - filters keep a flat color flat, shrinking and growing
+{
+  var color = 0x80402010;
+  var image = makeImage(37, 23, Format.Format_ARGB32_Premultiplied, 
+      function() { return color; });
+
+  ['smooth', 'lanczos'].forEach(function(mode) {
+    [[10, 7], [80, 50], [37, 5]].forEach(function(size) {
+      var scaled = image.scaled(size[0], size[1], { mode: mode });
+      assert.equal(scaled.width(), size[0]);
+      assert.equal(scaled.format(), Format.Format_ARGB32_Premultiplied);
+      for (var y = 0; y < size[1]; y++)
+        for (var x = 0; x < size[0]; x++)
+          assert.equal(pixel(scaled, x, y), color, mode + ' ' + size);
+    });
+  });
+}
+
+// scaled() - filters average fine detail away when shrinking
+{
+  var image = makeImage(64, 64, Format.Format_RGB32, function(x, y) {
+    return (x + y) % 2 ? 0xffffffff : 0xff000000;
+  });
+
+  ['smooth', 'lanczos'].forEach(function(mode) {
+    var scaled = image.scaled(16, 16, { mode: mode });
+    for (var y = 2; y < 14; y++) {
+      for (var x = 2; x < 14; x++) {
+        var gray = pixel(scaled, x, y) & 0xff;
+        assert.ok(Math.abs(gray - 128) < 8, mode + ': ' + gray);
+      }
+    }
+  });
+}
+
+// scaled() - options
+{
+  var image = makeImage(100, 50, Format.Format_ARGB32, function() {
+    return 0xff000000;
+  });
+
+  var kept = image.scaled(40, 40, { 
+    aspectRatioMode: qt.AspectRatioMode.KeepAspectRatio 
+  });
+  assert.equal(kept.width(), 40);
+  assert.equal(kept.height(), 20);
+  assert.equal(kept.format(), Format.Format_ARGB32);
+
+  var expanded = image.scaled(40, 40, { 
+    mode: 'smooth', 
+    aspectRatioMode: qt.AspectRatioMode.KeepAspectRatioByExpanding 
+  });
+  assert.equal(expanded.width(), 80);
+  assert.equal(expanded.height(), 40);
+
+  assert.ok(image.scaled(0, 10).isNull());
+  assert.ok(new qt.QImage().scaled(10, 10).isNull());
+
+  assert.throws(function() { image.scaled('10', 10); }, TypeError);
+  assert.throws(function() { 
+    image.scaled(10, 10, { mode: 'cubic' }); 
+  }, TypeError);
+}
+
+// scaled() - QPixmap
+{
+  var pixmap = new qt.QPixmap(30, 20);
+  var scaled = pixmap.scaled(15, 10, { mode: 'lanczos' });
+  assert.ok(scaled instanceof qt.QPixmap);
+  assert.equal(scaled.width(), 15);
+  assert.equal(scaled.height(), 10);
+}
+
+// transformed() - a quarter turn moves pixels exactly
+{
+  var image = makeImage(3, 2, Format.Format_ARGB32_Premultiplied, 
+      function(x, y) { return 0xff000000 | (y * 3 + x); });
+
+  var rotated = image.transformed(new qt.QTransform().rotate(90));
+  assert.equal(rotated.width(), 2);
+  assert.equal(rotated.height(), 3);
+  assert.equal(pixel(rotated, 0, 0), pixel(image, 0, 1));
+  assert.equal(pixel(rotated, 1, 0), pixel(image, 0, 0));
+  assert.equal(pixel(rotated, 0, 2), pixel(image, 2, 1));
+
+  // QMatrix works too
+  var flipped = image.transformed(new qt.QMatrix(-1, 0, 0, 1, 0, 0));
+  assert.equal(pixel(flipped, 0, 0), pixel(image, 2, 0));
+}
+
+// transformed() - smooth
+{
+  var color = 0xff336699 >>> 0;
+  var image = makeImage(4, 4, Format.Format_RGB32, function() {
+    return color;
+  });
+
+  // Upscaled borders stay opaque
+  var scaled = image.transformed(new qt.QTransform().scale(2, 2), 
+                                 { mode: 'smooth' });
+  assert.equal(scaled.width(), 8);
+  assert.equal(scaled.format(), Format.Format_ARGB32_Premultiplied);
+  for (var y = 0; y < 8; y++)
+    for (var x = 0; x < 8; x++)
+      assert.equal(pixel(scaled, x, y), color);
+
+  // Corners outside a rotated image are transparent, edges partly so
+  var rotated = image.scaled(40, 40).transformed(
+      new qt.QTransform().rotate(45), { mode: 'smooth' });
+  var size = rotated.width();
+  assert.equal(pixel(rotated, 0, 0), 0);
+  assert.equal(pixel(rotated, size >> 1, size >> 1), color);
+
+  assert.throws(function() { image.transformed(); }, TypeError);
+  assert.throws(function() { 
+    image.transformed(new qt.QTransform(), { mode: 'lanczos' }); 
+  }, TypeError);
+}
+
+//
+// compareImages()
+//
+
+// Identical images
+{
+  var a = makeImage(300, 200, Format.Format_ARGB32, function(x, y) {
+    return 0xff000000 | x << 8 | y;
+  });
+  var b = makeImage(300, 200, Format.Format_ARGB32, function(x, y) {
+    return 0xff000000 | x << 8 | y;
+  });
+
+  var result = qt.compareImages(a, b);
+  assert.equal(result.match, true);
+  assert.equal(result.width, 300);
+  assert.equal(result.height, 200);
+  assert.equal(result.diffPixels, 0);
+  assert.equal(result.maxDelta, 0);
+  assert.strictEqual(result.bounds, null);
+  assert.equal(result.diffImage, undefined);
+}
+
+// Differences, tolerance, maxDiffPixels and bounds
+{
+  var a = makeImage(300, 200, Format.Format_RGB32, function() {
+    return 0xff808080;
+  });
+  var b = makeImage(300, 200, Format.Format_RGB32, function(x, y) {
+    // A 3px delta block and a single 40px delta pixel, in different bands
+    if (x >= 10 && x < 20 && y >= 100 && y < 105)
+      return 0xff838080;
+    if (x === 250 && y === 150)
+      return 0xff80a880;
+    return 0xff808080;
+  });
+
+  var result = qt.compareImages(a, b, { diffImage: true });
+  assert.equal(result.match, false);
+  assert.equal(result.diffPixels, 51);
+  assert.equal(result.maxDelta, 40);
+  assert.deepEqual(result.bounds, { x: 10, y: 100, width: 241, height: 51 });
+
+  var diff = result.diffImage;
+  assert.ok(diff instanceof qt.QImage);
+  assert.equal(diff.width(), 300);
+  assert.equal(pixel(diff, 12, 101), 0xffff0000);
+  assert.notEqual(pixel(diff, 0, 0), 0xffff0000);
+
+  result = qt.compareImages(a, b, { tolerance: 3 });
+  assert.equal(result.diffPixels, 1);
+  assert.equal(result.maxDelta, 40);
+  assert.deepEqual(result.bounds, { x: 250, y: 150, width: 1, height: 1 });
+
+  result = qt.compareImages(a, b, { tolerance: 3, maxDiffPixels: 1 });
+  assert.equal(result.match, true);
+}
+
+// Premultiplied comparison: color under zero alpha doesn't count
+{
+  var a = makeImage(4, 4, Format.Format_ARGB32, function() {
+    return 0x00ff0000;
+  });
+  var b = makeImage(4, 4, Format.Format_ARGB32, function() {
+    return 0x0000ff00;
+  });
+  assert.equal(qt.compareImages(a, b).match, true);
+}
+
+// QPixmap arguments, size mismatch, bad arguments
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  pixmap.fill(new qt.QColor(255, 0, 0));
+  var image = pixmap.toImage();
+  assert.equal(qt.compareImages(pixmap, image).match, true);
+
+  var result = qt.compareImages(pixmap, new qt.QPixmap(10, 11));
+  assert.equal(result.match, false);
+  assert.equal(result.sizeMismatch, true);
+
+  assert.throws(function() { qt.compareImages(pixmap); }, TypeError);
+  assert.throws(function() { qt.compareImages(pixmap, {}); }, TypeError);
+}
+
+//
+// Asynchronous loading
+//
+
+// load() - path
+qt.QImage.load('resources/qimage.png').then(function(image) {
+  assert.ok(image instanceof qt.QImage);
+  assert.equal(image.width(), 100);
+  assert.equal(image.height(), 100);
+}).catch(test.fail);
+
+// load() - Buffer, scaled decode keeps the aspect ratio
+qt.QImage.load(require('fs').readFileSync('resources/qimage.png'), 
+    { format: 'PNG', width: 50 }).then(function(image) {
+  assert.equal(image.width(), 50);
+  assert.equal(image.height(), 50);
+}).catch(test.fail);
+
+// load() - bad file rejects
+qt.QImage.load('BAD-FILE').then(function() {
+  test.fail(new Error('load() of a missing file resolved'));
+}, function(err) {
+  assert.ok(err instanceof Error);
+});
+
+// load() - bad arguments reject
+qt.QImage.load(42).then(function() {
+  test.fail(new Error('load() of a number resolved'));
+}, function(err) {
+  assert.ok(err instanceof TypeError);
+});
+
+// cancel() - queued loads reject with ECANCELED
+{
+  qt.QImage.setLoadConcurrency(1);
+
+  var loads = [];
+  for (var i = 0; i < 4; i++)
+    loads.push(qt.QImage.load('resources/qimage.png'));
+  loads[3].cancel();
+
+  loads[3].then(function() {
+    test.fail(new Error('cancelled load resolved'));
+  }, function(err) {
+    assert.equal(err.code, 'ECANCELED');
+  });
+  Promise.all(loads.slice(0, 3)).then(function(images) {
+    assert.equal(images.length, 3);
+    qt.QImage.setLoadConcurrency(4);
+  }).catch(test.fail);
+
+  assert.throws(function() {
+    qt.QImage.setLoadConcurrency(0);
+  }, TypeError);
+}
+
+// saveAsync() - Buffer round trip
+{
+  var image = new qt.QImage('resources/qimage.png');
+  image.saveAsync(null, 'PNG').then(function(buffer) {
+    var decoded = new qt.QImage(buffer);
+    assert.equal(decoded.width(), 100);
+    assert.equal(decoded.height(), 100);
+  }).catch(test.fail);
+}
+
+// saveAsync() - JPEG quality
+{
+  var image = new qt.QImage('resources/qimage.png');
+  Promise.all([
+    image.saveAsync(null, 'JPEG', 10),
+    image.saveAsync(null, 'JPEG', 95)
+  ]).then(function(buffers) {
+    assert.ok(buffers[0].length < buffers[1].length);
+  }).catch(test.fail);
+}
+
+// scaledAsync(), transformedAsync()
+{
+  var image = makeImage(64, 48, Format.Format_RGB32, function(x, y) {
+    return 0xff000000 | (x * 4 << 8) | y * 5;
+  });
+  var expected = image.scaled(20, 15, { mode: 'lanczos' });
+
+  image.scaledAsync(20, 15, { mode: 'lanczos' }).then(function(scaled) {
+    assert.ok(scaled.bits().equals(expected.bits()));
+  }).catch(test.fail);
+
+  image.transformedAsync(new qt.QTransform().rotate(90)).then(function(t) {
+    assert.equal(t.width(), 48);
+    assert.equal(t.height(), 64);
+  }).catch(test.fail);
+
+  image.scaledAsync(10, 10, { mode: 'bicubic' }).then(function() {
+    test.fail(new Error('scaledAsync() with a bad mode resolved'));
+  }, function(err) {
+    assert.ok(err instanceof TypeError);
+  });
+}
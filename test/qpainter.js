@@ -216,6 +216,354 @@ var width = 100, height = 100;
                  // get GC'd before painter is done (segfault!)
 }
 
+// execute() - crash test
+{
+  var pixmap1 = new qt.QPixmap(100, 100);
+  var pixmap2 = new qt.QPixmap(10, 10);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap1);
+
+  var Op = qt.QPainter.Op;
+  var commands = new Float64Array([
+    Op.Save,
+    Op.SetPen, 1,
+    Op.FillRect, 0, 0, 10, 10, 0xff00ff00,
+    Op.DrawText, 0, 20, 0,
+    Op.DrawPixmap, 20, 20, 0,
+    Op.SetMatrix, 1, 0, 0, 1, 5, 5,
+    Op.Restore
+  ]);
+  painter.execute(commands, ['hello'], [pixmap2, new qt.QPen]);
+  painter.execute(new Int32Array([Op.FillRect, 0, 0, 10, 10, 0xff0000ff]));
+
+  painter.end(); // calling .end() before leaving scope ensures pixmaps won't 
+                 // get GC'd before painter is done (segfault!)
+}
+
+// execute() - wrong args
+{
+  var pixmap1 = new qt.QPixmap(100, 100);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap1);
+
+  var Op = qt.QPainter.Op;
+  [
+    [[Op.FillRect, 0, 0]],                                  // not a typed array
+    [new Float64Array([Op.FillRect, 0, 0])],                // truncated
+    [new Float64Array([99])],                               // unknown opcode
+    [new Float64Array([Op.DrawText, 0, 0, 3]), ['a']],      // bad string index
+    [new Float64Array([Op.SetPen, 0]), [], [pixmap1]],      // not a pen
+    [new Float64Array([NaN])],                              // NaN opcode
+    [new Float64Array([Op.FillRect, Infinity, 0, 1, 1, 0])],// infinite arg
+    [new Float64Array([Op.FillRect, 1e20, 0, 1, 1, 0])],    // out of range
+    [new Float64Array([Op.FillRect, 0, 0, 1, 1, NaN])]      // NaN color
+  ].forEach(function(args) {
+    var flag = false;
+    try {
+      painter.execute.apply(painter, args);
+    } catch (e) {
+      flag = true;
+    }
+    assert.ok(flag, 'execute should throw error with bad args');
+  });
+
+  painter.end(); // calling .end() before leaving scope ensures pixmaps won't 
+                 // get GC'd before painter is done (segfault!)
+}
+
+// execute() - a failing stream restores the painter state it saved
+{
+  var image = new qt.QImage(new Buffer(10 * 10 * 4), 10, 10, 40, 
+      qt.QImage.Format.Format_RGB32);
+  image.bits().fill(0);
+  var painter = new qt.QPainter;
+  painter.begin(image);
+
+  var Op = qt.QPainter.Op;
+  assert.throws(function() {
+    painter.execute(new Float64Array([Op.Save, Op.SetMatrix, 1, 0, 0, 1, 5, 5, 
+        99]));
+  });
+
+  // Untranslated again: (0, 0) gets painted
+  painter.fillRect(0, 0, 1, 1, qt.GlobalColor.white);
+  painter.end();
+  assert.equal(image.bits().readUInt32LE(0), 0xffffffff);
+}
+
+// drawPolyline() / drawPolygon() / drawPoints() / drawLines()
+{
+  var image = new qt.QImage(new Buffer(50 * 50 * 4), 50, 50, 200, 
+      qt.QImage.Format.Format_RGB32);
+  image.bits().fill(0);
+  var painter = new qt.QPainter;
+  var points = new Float64Array([5, 5, 45, 5, 45, 45, 5, 45]);
+
+  painter.begin(image);
+  painter.setPen(new qt.QPen(new qt.QColor(255, 255, 255)));
+  painter.drawPolyline(points);
+  painter.drawPolygon(points, qt.FillRule.WindingFill);
+  painter.drawPolygon(points);
+  painter.drawPoints(points);
+  painter.drawLines(new Float64Array([0, 49, 49, 49]));
+  painter.end();
+
+  // Corner of the polyline and a point on the bottom line are white
+  var bits = image.bits();
+  assert.equal(bits[(5 * 50 + 5) * 4], 255);
+  assert.equal(bits[(49 * 50 + 25) * 4], 255);
+}
+
+// drawPolyline() etc - wrong args
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap);
+  ['drawPolyline', 'drawPolygon', 'drawPoints', 'drawLines'].forEach(
+      function(method) {
+    assert.throws(function() {
+      painter[method]([0, 0, 1, 1]);
+    }, TypeError);
+    assert.throws(function() {
+      painter[method](new Float32Array(4));
+    }, TypeError);
+  });
+  painter.end();
+}
+
+// fillPath() - a stroke outlined once, then filled
+{
+  var path = new qt.QPainterPath;
+  path.moveTo(new qt.QPointF(5, 20));
+  path.lineTo(new qt.QPointF(35, 20));
+
+  var stroker = new qt.QPainterPathStroker;
+  stroker.setWidth(6);
+  stroker.setCapStyle(qt.PenCapStyle.FlatCap);
+  var outline = stroker.createStroke(path);
+
+  var image = new qt.QImage(new Buffer(40 * 40 * 4), 40, 40, 160, 
+      qt.QImage.Format.Format_ARGB32);
+  image.bits().fill(0);
+  var painter = new qt.QPainter;
+  painter.begin(image);
+  painter.fillPath(outline, new qt.QColor(255, 0, 0));
+  painter.end();
+
+  function pixel(x, y) { return image.bits().readUInt32LE((y * 40 + x) * 4); }
+  assert.equal(pixel(20, 20), 0xffff0000);
+  assert.equal(pixel(20, 18), 0xffff0000);
+  assert.equal(pixel(20, 10), 0);
+  assert.equal(pixel(2, 20), 0);
+
+  painter.begin(image);
+  painter.fillPath(outline, new qt.QBrush(qt.GlobalColor.blue));
+  painter.fillPath(outline, qt.GlobalColor.green);
+  assert.throws(function() { painter.fillPath(outline); }, TypeError);
+  assert.throws(function() { 
+    painter.fillPath({}, new qt.QColor(0, 0, 0)); 
+  }, TypeError);
+  painter.end();
+}
+
+// fillRects() - matches per-call fillRect()
+{
+  var rects = new Int32Array([0, 0, 10, 10,  20, 0, 10, 10,  0, 20, 30, 5]);
+  var colors = new Uint32Array([0xffff0000, 0xff00ff00, 0xffff0000]);
+
+  var expected = new qt.QImage(new Buffer(40 * 40 * 4), 40, 40, 160, 
+      qt.QImage.Format.Format_ARGB32);
+  expected.bits().fill(0);
+  var painter = new qt.QPainter;
+  painter.begin(expected);
+  painter.fillRect(0, 0, 10, 10, new qt.QColor(255, 0, 0));
+  painter.fillRect(20, 0, 10, 10, new qt.QColor(0, 255, 0));
+  painter.fillRect(0, 20, 30, 5, new qt.QColor(255, 0, 0));
+  painter.end();
+
+  var image = new qt.QImage(new Buffer(40 * 40 * 4), 40, 40, 160, 
+      qt.QImage.Format.Format_ARGB32);
+  image.bits().fill(0);
+  painter.begin(image);
+  painter.fillRects(rects, colors);
+  painter.end();
+
+  assert.ok(image.bits().equals(expected.bits()), 'fillRects matches');
+
+  // A single color for all rects
+  function render(draw) {
+    var result = new qt.QImage(new Buffer(40 * 40 * 4), 40, 40, 160, 
+        qt.QImage.Format.Format_ARGB32);
+    result.bits().fill(0);
+    painter.begin(result);
+    draw();
+    painter.end();
+    return result.bits();
+  }
+
+  var qcolors = [new qt.QColor(255, 0, 0), new qt.QColor(0, 255, 0), 
+                 new qt.QColor(255, 0, 0)];
+
+  assert.ok(render(function() {
+    painter.fillRects(rects, new Uint32Array([0xff0000ff]));
+  }).equals(render(function() {
+    for (var i = 0; i < 3; i++) {
+      painter.fillRect(rects[i * 4], rects[i * 4 + 1], rects[i * 4 + 2], 
+          rects[i * 4 + 3], new qt.QColor(0, 0, 255));
+    }
+  })), 'fillRects with a single color matches');
+
+  // drawRects() outlines with the current pen, or each rect's color
+  var outlines = render(function() { painter.drawRects(rects); });
+  assert.equal(outlines.readUInt32LE(0), 0xff000000);
+  assert.equal(outlines.readUInt32LE((5 * 40 + 5) * 4), 0);
+  assert.ok(outlines.equals(render(function() {
+    for (var i = 0; i < 3; i++)
+      painter.drawRects(rects.subarray(i * 4, i * 4 + 4));
+  })), 'drawRects matches one rect at a time');
+
+  var colored = render(function() { painter.drawRects(rects, colors); });
+  assert.equal(colored.readUInt32LE(0), 0xffff0000);
+  assert.equal(colored.readUInt32LE(20 * 4), 0xff00ff00);
+  assert.ok(colored.equals(render(function() {
+    for (var i = 0; i < 3; i++) {
+      painter.setPen(new qt.QPen(qcolors[i]));
+      painter.drawRects(rects.subarray(i * 4, i * 4 + 4));
+    }
+  })), 'drawRects with colors matches per-rect pens');
+}
+
+// fillRects() / drawRects() - wrong args
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap);
+
+  var rects = new Int32Array([0, 0, 1, 1, 2, 2, 1, 1]);
+  assert.throws(function() { painter.fillRects([0, 0, 1, 1]); }, TypeError);
+  assert.throws(function() { painter.fillRects(rects); }, TypeError);
+  assert.throws(function() {
+    painter.fillRects(rects, new Uint32Array(3));
+  }, TypeError);
+  assert.throws(function() {
+    painter.drawRects(rects, new Int32Array(2));
+  }, TypeError);
+
+  painter.end();
+}
+
+// renderTiled() - matches a single-threaded execute()
+{
+  var Op = qt.QPainter.Op;
+  var sprite = new qt.QPixmap(16, 16);
+  sprite.fill(new qt.QColor(0, 0, 255));
+
+  var commands = new Float64Array([
+    Op.FillRect, 0, 0, 300, 200, 0xffffffff,
+    Op.FillRect, 10, 10, 250, 30, 0xffff0000,
+    Op.FillRect, 50, 50, 100, 100, 0x8000ff00,
+    Op.DrawPixmap, 120, 90, 0,
+    Op.SetMatrix, 1, 0, 0, 1, 40, 60,
+    Op.FillRect, 90, 90, 40, 40, 0xff000000
+  ]);
+
+  var expected = new qt.QImage(new Buffer(300 * 200 * 4), 300, 200, 1200, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+  var painter = new qt.QPainter;
+  painter.begin(expected);
+  painter.execute(commands, null, [sprite]);
+  painter.end();
+
+  var image = new qt.QImage(new Buffer(300 * 200 * 4), 300, 200, 1200, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+  var tiles = [];
+  var count = qt.QPainter.renderTiled(image, commands, null, [sprite], {
+    tileSize: 64,
+    onTile: function(x, y, w, h) { tiles.push([x, y, w, h]); }
+  });
+
+  assert.equal(count, 5 * 4);
+  assert.equal(tiles.length, count);
+  assert.ok(image.bits().equals(expected.bits()), 'tiles match execute()');
+}
+
+// renderTiled() - onTile may reuse the command array while tiles render
+{
+  var Op = qt.QPainter.Op;
+  var commands = new Float64Array([
+    Op.FillRect, 0, 0, 256, 256, 0xffffffff,
+    Op.FillRect, 30, 30, 180, 60, 0xff00ff00,
+    Op.SetMatrix, 1, 0, 0, 1, 20, 100,
+    Op.FillRect, 0, 0, 200, 100, 0x800000ff
+  ]);
+
+  var expected = new qt.QImage(new Buffer(256 * 256 * 4), 256, 256, 1024, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+  var painter = new qt.QPainter;
+  painter.begin(expected);
+  painter.execute(commands);
+  painter.end();
+
+  var image = new qt.QImage(new Buffer(256 * 256 * 4), 256, 256, 1024, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+  qt.QPainter.renderTiled(image, commands, null, null, {
+    tileSize: 16,
+    onTile: function() {
+      // Next frame's stream, or garbage
+      commands.fill(99);
+    }
+  });
+
+  assert.ok(image.bits().equals(expected.bits()), 
+      'tiles replay the stream as it was passed');
+}
+
+// renderTiled() - text is rendered in parallel only where the platform
+// supports it, and tile by tile on this thread elsewhere
+{
+  var Op = qt.QPainter.Op;
+  var commands = new Float64Array([
+    Op.FillRect, 0, 0, 128, 128, 0xffffffff,
+    Op.DrawText, 10, 30, 0,
+    Op.DrawText, 60, 90, 1
+  ]);
+
+  var image = new qt.QImage(new Buffer(128 * 128 * 4), 128, 128, 512, 
+      qt.QImage.Format.Format_ARGB32_Premultiplied);
+  var tiles = 0;
+  var count = qt.QPainter.renderTiled(image, commands, ['tiled', 'text'], 
+      null, { tileSize: 32, onTile: function() { tiles++; } });
+
+  assert.equal(count, 4 * 4);
+  assert.equal(tiles, count);
+}
+
+// renderTiled() - wrong args and errors
+{
+  var image = new qt.QImage(new Buffer(64 * 64 * 4), 64, 64, 256, 
+      qt.QImage.Format.Format_RGB32);
+
+  assert.throws(function() {
+    qt.QPainter.renderTiled(new qt.QPixmap(10, 10), new Float64Array(0));
+  }, TypeError);
+  assert.throws(function() {
+    qt.QPainter.renderTiled(image, [1, 2, 3]);
+  }, TypeError);
+  assert.throws(function() {
+    qt.QPainter.renderTiled(image, new Float64Array([99]));
+  }, Error);
+
+  // Exceptions from onTile propagate after all tiles finish
+  var calls = 0;
+  assert.throws(function() {
+    qt.QPainter.renderTiled(image, new Float64Array(0), null, null, {
+      tileSize: 16,
+      onTile: function() { calls++; throw new Error('stop'); }
+    });
+  }, /stop/);
+  assert.equal(calls, 1);
+}
+
 //
 // Regression tests
 //
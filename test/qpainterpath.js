@@ -72,3 +72,137 @@ var app = new qt.QApplication();
   assert.equal(point2.x(), 0);
   assert.equal(point2.y(), 0);  
 }
+
+// elementCount
+{
+  var path = new qt.QPainterPath;
+  assert.equal(path.elementCount(), 0);
+  path.moveTo(new qt.QPointF(1, 2));
+  path.lineTo(new qt.QPointF(3, 4));
+  assert.equal(path.elementCount(), 2);
+}
+
+// fromArrays
+{
+  var Verb = qt.QPainterPath.Verb;
+  var verbs = new Uint8Array([Verb.MoveTo, Verb.LineTo, Verb.CubicTo,
+                              Verb.QuadTo]);
+  var coords = new Float64Array([0, 0,  10, 0,  10, 5, 5, 10, 0, 10,
+                                 5, 20, 10, 20]);
+  var path = qt.QPainterPath.fromArrays(verbs, coords);
+  assert.ok(path instanceof qt.QPainterPath);
+  // Curves take three elements each
+  assert.equal(path.elementCount(), 8);
+  assert.equal(path.currentPosition().x(), 10);
+  assert.equal(path.currentPosition().y(), 20);
+
+  path = qt.QPainterPath.fromArrays(
+      new Uint8Array([Verb.MoveTo, Verb.LineTo, Verb.LineTo, Verb.Close]),
+      new Float64Array([1, 1, 5, 1, 5, 5]));
+  assert.equal(path.currentPosition().x(), 1);
+  assert.equal(path.currentPosition().y(), 1);
+
+  path = qt.QPainterPath.fromArrays(new Uint8Array(0), new Float64Array(0));
+  assert.equal(path.elementCount(), 0);
+
+  // Unknown verb
+  assert.throws(function() {
+    qt.QPainterPath.fromArrays(new Uint8Array([9]), new Float64Array(2));
+  }, TypeError);
+
+  // Not enough coords
+  assert.throws(function() {
+    qt.QPainterPath.fromArrays(new Uint8Array([Verb.MoveTo, Verb.CubicTo]), 
+                               new Float64Array(4));
+  }, TypeError);
+
+  // Wrong array types
+  assert.throws(function() {
+    qt.QPainterPath.fromArrays([0, 1], [0, 0, 1, 1]);
+  }, TypeError);
+  assert.throws(function() {
+    qt.QPainterPath.fromArrays(new Uint8Array(1), new Float32Array(2));
+  }, TypeError);
+}
+
+// fromSvg
+{
+  var path = qt.QPainterPath.fromSvg('M10 20 L30 40');
+  assert.equal(path.elementCount(), 2);
+  assert.equal(path.currentPosition().x(), 30);
+  assert.equal(path.currentPosition().y(), 40);
+
+  // Relative commands, H/V and compact number syntax
+  path = qt.QPainterPath.fromSvg('m10,20l5-5h10v.5');
+  assert.equal(path.elementCount(), 4);
+  assert.equal(path.currentPosition().x(), 25);
+  assert.equal(path.currentPosition().y(), 15.5);
+
+  // Implicit repeats: pairs after M are line-tos
+  path = qt.QPainterPath.fromSvg('M0 0 10 0 10 10z');
+  assert.equal(path.currentPosition().x(), 0);
+  assert.equal(path.currentPosition().y(), 0);
+
+  // Exponents
+  path = qt.QPainterPath.fromSvg('M1e1 2E-1');
+  assert.equal(path.currentPosition().x(), 10);
+  assert.equal(path.currentPosition().y(), 0.2);
+
+  // Same doubles as JS number parsing, and huge exponents saturate
+  path = qt.QPainterPath.fromSvg('M0.3 -1.1e-2');
+  assert.strictEqual(path.currentPosition().x(), 0.3);
+  assert.strictEqual(path.currentPosition().y(), -0.011);
+  path = qt.QPainterPath.fromSvg('M0e99999999999 1e-99999999999');
+  assert.equal(path.elementCount(), 1);
+  assert.equal(path.currentPosition().x(), 0);
+  assert.equal(path.currentPosition().y(), 0);
+
+  // Curves, with smooth reflection
+  path = qt.QPainterPath.fromSvg('M0 0 C0 10 10 10 10 0 S20 -10 20 0 ' +
+                                 'Q25 10 30 0 T40 0');
+  assert.equal(path.elementCount(), 1 + 4 * 3);
+  assert.equal(path.currentPosition().x(), 40);
+
+  // A half-circle arc is split into two 90 degree cubics
+  path = qt.QPainterPath.fromSvg('M0 0 A10 10 0 0 1 20 0');
+  assert.equal(path.elementCount(), 1 + 2 * 3);
+  assert.equal(path.currentPosition().x(), 20);
+  assert.equal(path.currentPosition().y(), 0);
+
+  // Relative arc with flags packed together
+  path = qt.QPainterPath.fromSvg('M0 0a5 5 0 1020 0');
+  assert.equal(path.currentPosition().x(), 20);
+
+  assert.equal(qt.QPainterPath.fromSvg('').elementCount(), 0);
+
+  // Malformed data
+  assert.throws(function() { qt.QPainterPath.fromSvg('L10 10'); }, TypeError);
+  assert.throws(function() { qt.QPainterPath.fromSvg('M10'); }, TypeError);
+  assert.throws(function() { qt.QPainterPath.fromSvg('M0 0 X1'); }, TypeError);
+  assert.throws(function() { qt.QPainterPath.fromSvg(42); }, TypeError);
+}
+
+// boundingRect
+{
+  var path = new qt.QPainterPath;
+  var rect = path.boundingRect();
+  assert.deepEqual(rect, { x: 0, y: 0, width: 0, height: 0 });
+
+  path = qt.QPainterPath.fromSvg('M10 20 L40 20 L40 60');
+  rect = path.boundingRect();
+  assert.equal(rect.x, 10);
+  assert.equal(rect.y, 20);
+  assert.equal(rect.width, 30);
+  assert.equal(rect.height, 40);
+}
+
+// simplified
+{
+  // Two overlapping squares merge into one outline
+  var path = qt.QPainterPath.fromSvg('M0 0 H10 V10 H0 Z M5 0 H15 V10 H5 Z');
+  var simple = path.simplified();
+  assert.ok(simple instanceof qt.QPainterPath);
+  assert.ok(simple !== path);
+  assert.ok(simple.elementCount() < path.elementCount());
+  assert.deepEqual(simple.boundingRect(), path.boundingRect());
+}
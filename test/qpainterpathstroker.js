@@ -0,0 +1,110 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..'),
+    test = require('./test');
+    
+var app = new qt.QApplication();
+
+// Constructor
+{
+  var stroker = new qt.QPainterPathStroker;
+  assert.ok(stroker);
+  assert.equal(stroker.width(), 1);
+  assert.equal(stroker.capStyle(), qt.PenCapStyle.SquareCap);
+  assert.equal(stroker.joinStyle(), qt.PenJoinStyle.BevelJoin);
+}
+
+// Constructor - from a pen
+{
+  var pen = new qt.QPen(new qt.QBrush(qt.GlobalColor.black), 4, 
+                        qt.PenStyle.DashLine, qt.PenCapStyle.RoundCap, 
+                        qt.PenJoinStyle.MiterJoin);
+  var stroker = new qt.QPainterPathStroker(pen);
+  assert.equal(stroker.width(), 4);
+  assert.equal(stroker.capStyle(), qt.PenCapStyle.RoundCap);
+  assert.equal(stroker.joinStyle(), qt.PenJoinStyle.MiterJoin);
+
+  // Cosmetic pens stroke one unit wide
+  stroker = new qt.QPainterPathStroker(new qt.QPen(new qt.QColor(0, 0, 0)));
+  assert.equal(stroker.width(), 1);
+}
+
+// Setters
+{
+  var stroker = new qt.QPainterPathStroker;
+  stroker.setWidth(2.5);
+  assert.equal(stroker.width(), 2.5);
+  stroker.setCapStyle(qt.PenCapStyle.FlatCap);
+  assert.equal(stroker.capStyle(), qt.PenCapStyle.FlatCap);
+  stroker.setJoinStyle(qt.PenJoinStyle.RoundJoin);
+  assert.equal(stroker.joinStyle(), qt.PenJoinStyle.RoundJoin);
+  stroker.setMiterLimit(3);
+  assert.equal(stroker.miterLimit(), 3);
+  stroker.setCurveThreshold(0.5);
+  assert.equal(stroker.curveThreshold(), 0.5);
+  stroker.setDashOffset(2);
+  assert.equal(stroker.dashOffset(), 2);
+
+  assert.throws(function() { stroker.setWidth('2'); }, TypeError);
+  assert.throws(function() { stroker.setCapStyle(); }, TypeError);
+  assert.throws(function() { stroker.setDashPattern('dash'); }, TypeError);
+}
+
+// createStroke
+{
+  var path = new qt.QPainterPath;
+  path.moveTo(new qt.QPointF(0, 10));
+  path.lineTo(new qt.QPointF(100, 10));
+
+  var stroker = new qt.QPainterPathStroker;
+  stroker.setWidth(4);
+  stroker.setCapStyle(qt.PenCapStyle.FlatCap);
+  var outline = stroker.createStroke(path);
+  assert.ok(outline instanceof qt.QPainterPath);
+
+  var rect = outline.boundingRect();
+  assert.equal(rect.x, 0);
+  assert.equal(rect.y, 8);
+  assert.equal(rect.width, 100);
+  assert.equal(rect.height, 4);
+
+  // Dashes split the outline into many subpaths
+  stroker.setDashPattern(qt.PenStyle.DashLine);
+  var dashed = stroker.createStroke(path);
+  assert.ok(dashed.elementCount() > outline.elementCount());
+
+  stroker.setDashPattern([1, 1]);
+  var custom = stroker.createStroke(path);
+  assert.ok(custom.elementCount() > dashed.elementCount());
+
+  assert.throws(function() { stroker.createStroke(); }, TypeError);
+  assert.throws(function() { stroker.createStroke({}); }, TypeError);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..');
+
+var app = new qt.QApplication();
+
+// Constructor
+{
+  var picture = new qt.QPicture;
+  assert.ok(picture);
+  assert.equal(picture.isNull(), true);
+}
+
+// Record and replay
+{
+  var picture = new qt.QPicture;
+  var painter = new qt.QPainter;
+
+  assert.equal(painter.begin(picture), true);
+  painter.fillRect(0, 0, 10, 10, new qt.QColor(255, 0, 0));
+  painter.end();
+  assert.equal(picture.isNull(), false);
+  assert.ok(picture.size() > 0);
+
+  var image = new qt.QImage(new Buffer(20 * 20 * 4), 20, 20, 80, 
+      qt.QImage.Format.Format_RGB32);
+  image.bits().fill(0);
+
+  painter.begin(image);
+  painter.drawPicture(5, 5, picture);
+  painter.end();
+
+  // 0xffff0000 little-endian, at (5, 5) but not at (0, 0)
+  var bits = image.bits(), at = (5 * 20 + 5) * 4;
+  assert.equal(bits[at + 2], 255);
+  assert.equal(bits[at + 1], 0);
+  assert.equal(bits[2], 0);
+}
+
+// data() / Buffer round trip
+{
+  var picture = new qt.QPicture;
+  var painter = new qt.QPainter;
+  painter.begin(picture);
+  painter.fillRect(0, 0, 10, 10, new qt.QColor(0, 0, 255));
+  painter.end();
+
+  var data = picture.data();
+  assert.ok(Buffer.isBuffer(data));
+  assert.equal(data.length, picture.size());
+
+  var copy = new qt.QPicture(data);
+  assert.equal(copy.isNull(), false);
+  assert.ok(copy.data().equals(data));
+
+  var other = new qt.QPicture;
+  other.setData(data);
+  assert.equal(other.size(), picture.size());
+}
+
+// Wrong args
+{
+  var painter = new qt.QPainter;
+  painter.begin(new qt.QPixmap(10, 10));
+  assert.throws(function() {
+    painter.drawPicture(0, 0, new qt.QPixmap(1, 1));
+  }, TypeError);
+  painter.end();
+
+  assert.throws(function() {
+    new qt.QPicture().setData('not a buffer');
+  }, TypeError);
+}
@@ -42,6 +42,75 @@ var app = new qt.QApplication();
   assert.equal(pixmap.height(), 60);
 }
 
+// Constructor - encoded Buffer
+{
+  var pixmap = new qt.QPixmap(fs.readFileSync('resources/qimage.png'));
+  assert.equal(pixmap.width(), 100);
+  assert.equal(pixmap.height(), 100);
+
+  var pixmap = new qt.QPixmap(fs.readFileSync('resources/qimage.png'), 'PNG');
+  assert.equal(pixmap.width(), 100);
+}
+
+// Constructor - raw pixel Buffer
+{
+  var pixels = new Buffer(4 * 3 * 2);
+  pixels.fill(0xff);
+  var pixmap = new qt.QPixmap(pixels, 3, 2, 12, 
+      qt.QImage.Format.Format_ARGB32);
+  assert.equal(pixmap.width(), 3);
+  assert.equal(pixmap.height(), 2);
+
+  assert.throws(function() {
+    new qt.QPixmap(pixels, 3, 3, 12, qt.QImage.Format.Format_ARGB32);
+  }, TypeError);
+}
+
+// Constructor - raw pixels in the native format don't alias the Buffer
+{
+  var Format = qt.QImage.Format;
+  var pixels = new Buffer(16 * 16 * 4);
+  pixels.fill(0x7f);
+  var pixmap = new qt.QPixmap(pixels, 16, 16, 64, 
+      Format.Format_ARGB32_Premultiplied);
+  pixels = null;
+
+  // Reuse the freed memory
+  test.gc();
+  for (var i = 0; i < 64; i++)
+    new Buffer(16 * 16 * 4).fill(0);
+
+  var image = pixmap.toImage().convertToFormat(
+      Format.Format_ARGB32_Premultiplied);
+  assert.ok(image.bits().equals(new Buffer(16 * 16 * 4).fill(0x7f)));
+}
+
+// fromImage(), toImage()
+{
+  var pixels = new Buffer(4 * 3 * 2);
+  pixels.fill(0x80);
+  var image = new qt.QImage(pixels, 3, 2, 12, 
+      qt.QImage.Format.Format_ARGB32);
+
+  var pixmap = qt.QPixmap.fromImage(image);
+  assert.ok(pixmap instanceof qt.QPixmap);
+  assert.equal(pixmap.width(), 3);
+  assert.equal(pixmap.height(), 2);
+  assert.equal(pixmap.hasAlphaChannel(), true);
+  assert.ok(pixmap.depth() > 0);
+
+  var back = pixmap.toImage();
+  assert.ok(back instanceof qt.QImage);
+  assert.equal(back.width(), 3);
+  assert.equal(back.hasAlphaChannel(), true);
+  // Semi-transparent 0x80 gray survives the round trip within rounding
+  var argb = back.convertToFormat(qt.QImage.Format.Format_ARGB32);
+  assert.ok(Math.abs(argb.bits()[0] - 0x80) <= 1);
+  assert.equal(argb.bits()[3], 0x80);
+
+  assert.throws(function() { qt.QPixmap.fromImage(pixmap); }, TypeError);
+}
+
 // save()
 {
   var pixmap = new qt.QPixmap(10, 10);
@@ -66,3 +135,58 @@ var app = new qt.QApplication();
     pixmap.fill(new qt.QColor(255, 0, 0));
   });
 }
+
+//
+// Asynchronous encoding
+//
+
+// saveAsync() - to Buffer, decodes back to the same size
+{
+  var pixmap = new qt.QPixmap(20, 10);
+  pixmap.fill(new qt.QColor(0, 0, 255));
+
+  pixmap.saveAsync(null, 'PNG').then(function(buffer) {
+    assert.ok(Buffer.isBuffer(buffer));
+    assert.equal(buffer.toString('ascii', 1, 4), 'PNG');
+
+    var decoded = new qt.QPixmap(buffer);
+    assert.equal(decoded.width(), 20);
+    assert.equal(decoded.height(), 10);
+  }).catch(test.fail);
+}
+
+// saveAsync() - PNG compression levels produce valid files
+{
+  var pixmap = new qt.QPixmap(64, 64);
+  pixmap.fill(new qt.QColor(0, 128, 0));
+
+  Promise.all([
+    pixmap.saveAsync(null, 'PNG', -1, { compression: 0 }),
+    pixmap.saveAsync(null, 'PNG', -1, { compression: 9 })
+  ]).then(function(buffers) {
+    assert.ok(buffers[1].length <= buffers[0].length);
+  }).catch(test.fail);
+}
+
+// saveAsync() - to file
+{
+  var file = '__pixmap-async.jpg';
+  var pixmap = new qt.QPixmap(10, 10);
+  pixmap.fill(new qt.QColor(255, 0, 0));
+
+  pixmap.saveAsync(file, null, 80).then(function(result) {
+    assert.equal(result, undefined);
+    assert.equal(fs.existsSync(file), true);
+    fs.unlinkSync(file);
+  }).catch(test.fail);
+}
+
+// saveAsync() - unknown format rejects
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  pixmap.saveAsync(null, 'NOT-A-FORMAT').then(function() {
+    test.fail(new Error('saveAsync() to an unknown format resolved'));
+  }, function(err) {
+    assert.ok(err instanceof Error);
+  });
+}
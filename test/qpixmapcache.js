@@ -0,0 +1,122 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..');
+
+var app = new qt.QApplication();
+
+var cache = qt.QPixmapCache;
+
+// insert() / find()
+{
+  cache.clear();
+  cache.resetStats();
+
+  var pixmap = new qt.QPixmap(20, 30);
+  assert.equal(cache.insert('sprite', pixmap), true);
+
+  var found = cache.find('sprite');
+  assert.ok(found instanceof qt.QPixmap);
+  assert.equal(found.width(), 20);
+  assert.equal(found.height(), 30);
+
+  assert.equal(cache.find('nothing'), null);
+
+  var stats = cache.stats();
+  assert.equal(stats.insertions, 1);
+  assert.equal(stats.hits, 1);
+  assert.equal(stats.misses, 1);
+  assert.equal(stats.evictedMisses, 0);
+}
+
+// A miss after remove() is not an evicted miss
+{
+  cache.clear();
+  cache.resetStats();
+
+  cache.insert('a', new qt.QPixmap(10, 10));
+  cache.remove('a');
+  assert.equal(cache.find('a'), null);
+  assert.equal(cache.stats().evictedMisses, 0);
+}
+
+// Cache limit evicts least recently used entries
+{
+  cache.clear();
+  cache.resetStats();
+
+  var limit = cache.cacheLimit();
+  cache.setCacheLimit(1024);
+  assert.equal(cache.cacheLimit(), 1024);
+
+  // 470-625 KB each depending on depth; 'a' is pushed out by the time 'c'
+  // is in
+  cache.insert('a', new qt.QPixmap(400, 400));
+  cache.insert('b', new qt.QPixmap(400, 400));
+  cache.insert('c', new qt.QPixmap(400, 400));
+  cache.find('a');
+
+  var stats = cache.stats();
+  assert.equal(stats.insertions, 3);
+  assert.equal(stats.misses, 1);
+  assert.equal(stats.evictedMisses, 1);
+
+  cache.setCacheLimit(limit);
+  cache.clear();
+}
+
+// Tracked keys are bounded (1024 at this limit): misses on keys inserted 
+// long ago count as plain misses
+{
+  cache.clear();
+  cache.resetStats();
+
+  var limit = cache.cacheLimit();
+  cache.setCacheLimit(1024);
+
+  var pixmap = new qt.QPixmap(100, 100);
+  for (var i = 0; i < 5000; i++)
+    cache.insert('key' + i, pixmap);
+
+  assert.equal(cache.find('key0'), null);
+  assert.equal(cache.stats().evictedMisses, 0);
+  assert.equal(cache.find('key4500'), null);
+  assert.equal(cache.stats().evictedMisses, 1);
+
+  cache.setCacheLimit(limit);
+  cache.clear();
+}
+
+// Wrong args
+{
+  assert.throws(function() { cache.insert('key', {}); }, TypeError);
+  assert.throws(function() { cache.find(42); }, TypeError);
+  assert.throws(function() { cache.setCacheLimit(-1); }, TypeError);
+}
@@ -87,6 +87,15 @@ var app = new qt.QApplication();
   assert.equal(area.widget(), 1);
 }
 
+// setWidget() - QWidget subclass
+{
+  var area = new qt.QScrollArea(),
+      label = new qt.QLabel('hello');
+
+  area.setWidget(label);
+  assert.equal(area.widget(), 1);
+}
+
 // scrollBars
 {
   var area = new qt.QScrollArea();
@@ -0,0 +1,90 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..');
+
+var app = new qt.QApplication();
+
+// Constructor
+{
+  var text = new qt.QStaticText;
+  assert.equal(text.text(), '');
+}
+
+// Constructor- text, font, width
+{
+  var text = new qt.QStaticText('hello world', new qt.QFont('helvetica', 12), 
+      40);
+  assert.equal(text.text(), 'hello world');
+  assert.equal(text.textWidth(), 40);
+  assert.ok(text.width() > 0);
+  assert.ok(text.height() > 0);
+}
+
+// setText(), setTextWidth()
+{
+  var text = new qt.QStaticText('a');
+  var narrow = text.width();
+  text.setText('a much longer label');
+  assert.ok(text.width() > narrow);
+
+  var tall = new qt.QStaticText('wrap this label onto several lines');
+  var lineHeight = tall.height();
+  tall.setTextWidth(20);
+  assert.ok(tall.height() > lineHeight);
+  tall.setTextWidth(-1);
+  assert.equal(tall.height(), lineHeight);
+}
+
+// drawStaticText()
+{
+  var pixmap = new qt.QPixmap(100, 30);
+  var painter = new qt.QPainter;
+  var text = new qt.QStaticText('label', new qt.QFont('helvetica', 10));
+  var font = new qt.QFont('courier', 20);
+
+  pixmap.fill();
+  painter.begin(pixmap);
+  painter.setFont(font);
+  painter.drawStaticText(0, 0, text);
+  painter.drawStaticText(0, 0, new qt.QStaticText('no font'));
+  painter.end();
+}
+
+// drawStaticText() - wrong args
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap);
+  assert.throws(function() {
+    painter.drawStaticText(0, 0, 'plain string');
+  }, TypeError);
+  painter.end();
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    qt = require('..'),
+    test = require('./test');
+    
+var app = new qt.QApplication();
+
+var Type = qt.QTransform.TransformationType;
+
+function assertClose(actual, expected) {
+  assert.equal(actual.length, expected.length);
+  for (var i = 0; i < expected.length; i++)
+    assert.ok(Math.abs(actual[i] - expected[i]) < 1e-9, 
+              'index ' + i + ': ' + actual[i] + ' != ' + expected[i]);
+}
+
+// Constructor
+{
+  var t = new qt.QTransform;
+  assert.ok(t.isIdentity());
+  assert.equal(t.type(), Type.TxNone);
+  assert.equal(t.m33(), 1);
+}
+
+// Constructor: components
+{
+  var t = new qt.QTransform(1, 2, 3, 4, 5, 6);
+  assert.equal(t.m11(), 1);
+  assert.equal(t.m12(), 2);
+  assert.equal(t.m21(), 3);
+  assert.equal(t.m22(), 4);
+  assert.equal(t.dx(), 5);
+  assert.equal(t.dy(), 6);
+  assert.ok(t.isAffine());
+
+  t = new qt.QTransform(1, 0, 0.001, 0, 1, 0, 0, 0, 1);
+  assert.equal(t.m13(), 0.001);
+  assert.ok(!t.isAffine());
+  assert.equal(t.type(), Type.TxProject);
+
+  assert.throws(function() { new qt.QTransform(1, 2, 3); }, TypeError);
+}
+
+// Constructor: QTransform and QMatrix
+{
+  var t = new qt.QTransform(1, 2, 3, 4, 5, 6);
+  var t2 = new qt.QTransform(t);
+  t.translate(10, 10);
+  assert.equal(t2.dx(), 5);
+
+  var t3 = new qt.QTransform(new qt.QMatrix(1, 2, 3, 4, 5, 6));
+  assert.equal(t3.m21(), 3);
+  assert.equal(t3.dy(), 6);
+}
+
+// translate, scale, rotate, shear
+{
+  var t = new qt.QTransform;
+  assert.equal(t.translate(10, 20), t);
+  assert.equal(t.type(), Type.TxTranslate);
+  assert.equal(t.scale(2, 3), t);
+  assert.equal(t.type(), Type.TxScale);
+  // Later operations apply to points first
+  assertClose(t.map(new Float64Array([1, 1])), [12, 23]);
+
+  t = new qt.QTransform().rotate(90);
+  assertClose(t.map(new Float64Array([1, 0])), [0, 1]);
+
+  t = new qt.QTransform().shear(1, 0);
+  assertClose(t.map(new Float64Array([0, 2])), [2, 2]);
+
+  t = new qt.QTransform().rotate(30, qt.Axis.YAxis);
+  assert.equal(t.type(), Type.TxProject);
+}
+
+// inverted, determinant
+{
+  var t = new qt.QTransform().translate(5, 5).scale(2, 4);
+  assert.equal(t.determinant(), 8);
+  assert.ok(t.isInvertible());
+
+  var points = new Float64Array([1, 2, -3, 4.5]);
+  var inverse = t.inverted();
+  assertClose(inverse.map(t.map(new Float64Array(points))), points);
+
+  var singular = new qt.QTransform(0, 0, 0, 0, 0, 0);
+  assert.ok(!singular.isInvertible());
+  assert.strictEqual(singular.inverted(), null);
+}
+
+// multiply
+{
+  var a = new qt.QTransform().translate(1, 0);
+  var b = new qt.QTransform().scale(2, 2);
+  var ab = a.multiply(b);
+  assert.ok(ab instanceof qt.QTransform);
+  assertClose(ab.map(new Float64Array([0, 0])), [2, 0]);
+  assertClose(b.multiply(a).map(new Float64Array([0, 0])), [1, 0]);
+
+  assert.throws(function() { a.multiply(new qt.QMatrix); }, TypeError);
+}
+
+// map - in place or into dst
+{
+  var t = new qt.QTransform().translate(1, 2);
+  var xy = new Float64Array([0, 0, 10, 10]);
+  assert.equal(t.map(xy), xy);
+  assertClose(xy, [1, 2, 11, 12]);
+
+  var dst = new Float64Array(4);
+  assert.equal(t.map(xy, dst), dst);
+  assertClose(dst, [2, 4, 12, 14]);
+  assertClose(xy, [1, 2, 11, 12]);
+
+  assert.equal(t.map(new Float64Array(0)).length, 0);
+
+  assert.throws(function() { t.map([0, 0]); }, TypeError);
+  assert.throws(function() { t.map(new Float32Array(2)); }, TypeError);
+  assert.throws(function() { t.map(new Float64Array(3)); }, TypeError);
+  assert.throws(function() { 
+    t.map(new Float64Array(4), new Float64Array(2)); 
+  }, TypeError);
+}
+
+// mapRects
+{
+  var t = new qt.QTransform().rotate(90);
+  var rects = new Float64Array([0, 0, 10, 20]);
+  assert.equal(t.mapRects(rects), rects);
+  assertClose(rects, [-20, 0, 20, 10]);
+
+  t = new qt.QTransform().scale(-1, 2).translate(5, 0);
+  assertClose(t.mapRects(new Float64Array([0, 0, 10, 10,  1, 1, 1, 1])), 
+              [-15, 0, 10, 20,  -7, 2, 1, 2]);
+
+  assert.throws(function() { t.mapRects(new Float64Array(6)); }, TypeError);
+}
+
+// quadToQuad - projective mapping
+{
+  var square = new Float64Array([0, 0, 100, 0, 100, 100, 0, 100]);
+  var trapezoid = new Float64Array([20, 0, 80, 0, 100, 100, 0, 100]);
+  var t = qt.QTransform.quadToQuad(square, trapezoid);
+  assert.equal(t.type(), Type.TxProject);
+  assertClose(t.map(new Float64Array(square)), trapezoid);
+
+  // Bounding rects agree with the mapped corners
+  var rect = t.mapRects(new Float64Array([0, 0, 100, 100]));
+  assertClose(rect, [0, 0, 100, 100]);
+
+  var degenerate = new Float64Array([0, 0, 0, 0, 0, 0, 0, 0]);
+  assert.strictEqual(qt.QTransform.quadToQuad(degenerate, square), null);
+
+  assert.throws(function() { 
+    qt.QTransform.quadToQuad(square, new Float64Array(6)); 
+  }, TypeError);
+}
+
+// painter.setTransform
+{
+  var pixmap = new qt.QPixmap(10, 10);
+  var painter = new qt.QPainter;
+  painter.begin(pixmap);
+
+  painter.setTransform(new qt.QTransform().translate(3, 4));
+  assert.equal(painter.transform().dx(), 3);
+  painter.setTransform(new qt.QTransform().translate(1, 1), true);
+  assert.equal(painter.transform().dx(), 4);
+  assert.equal(painter.transform().dy(), 5);
+  painter.setTransform(new qt.QTransform);
+  assert.ok(painter.transform().isIdentity());
+
+  assert.throws(function() { 
+    painter.setTransform(new qt.QMatrix); 
+  }, TypeError);
+
+  painter.end();
+}
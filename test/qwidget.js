@@ -130,3 +130,178 @@ var app = new qt.QApplication();
   assert.equal(capturedEvents[4].text(), 'a'); // keypress
   assert.equal(capturedEvents[5].key(), qt.Key.Key_Left); // keypress
 }
+
+// Events - 'object' and 'args' delivery modes
+{
+  var pressed = [], released = [], typed = [];
+  var reused = null;
+  var widget = new qt.QWidget;
+
+  widget.mousePressEvent(function(e) {
+    reused = reused || e;
+    assert.strictEqual(e, reused); // same object for every event
+    pressed.push([e.button, e.buttons, e.qevent().button()]);
+    assert.equal(typeof e.timestamp, 'number');
+  }, { mode: 'object' });
+
+  widget.mouseReleaseEvent(function(x, y, buttons, modifiers, timestamp, 
+      button) {
+    released.push([x, y, button, modifiers]);
+  }, { mode: 'args' });
+
+  widget.keyPressEvent(function(e) {
+    typed.push([e.key, e.text, e.qevent().text()]);
+  }, { mode: 'object' });
+
+  widget.keyReleaseEvent(function(key, modifiers, timestamp, text) {
+    typed.push(['release', key, text]);
+  }, { mode: 'args' });
+
+  widget.resize(100, 100); // QTest clicks at rect().center(), (49, 49)
+  widget.show();
+  app.processEvents();
+
+  var events = new qt.QTestEventList();
+  events.addMouseClick(qt.MouseButton.LeftButton);
+  events.addMouseClick(qt.MouseButton.RightButton);
+  events.addKeyPress('a');
+  events.simulate(widget);
+  app.processEvents();
+
+  var Left = qt.MouseButton.LeftButton, Right = qt.MouseButton.RightButton;
+  assert.deepEqual(pressed, [[Left, Left, Left], [Right, Right, Right]]);
+  assert.deepEqual(released, [[49, 49, Left, qt.KeyboardModifier.NoModifier],
+      [49, 49, Right, qt.KeyboardModifier.NoModifier]]);
+  assert.deepEqual(typed[0], [qt.Key.Key_A, 'a', 'a']);
+
+  // Rebinding without options goes back to wrappers
+  widget.mousePressEvent(function(e) {
+    assert.ok(e instanceof qt.QMouseEvent);
+  });
+
+  assert.throws(function() {
+    widget.mouseMoveEvent(function() {}, { mode: 'fast' });
+  }, TypeError);
+
+  widget.close();
+}
+
+// mouseMoveEvent() - coalescing
+{
+  var calls = [];
+  var widget = new qt.QWidget;
+  widget.resize(100, 100);
+  widget.setMouseTracking(true);
+  widget.show();
+  app.processEvents();
+
+  widget.mouseMoveEvent(function(x, y, points, buttons, modifiers) {
+    assert.ok(points instanceof Float64Array);
+    assert.equal(points.length % 3, 0);
+    assert.equal(buttons, qt.MouseButton.NoButton);
+    calls.push([x, y, Array.prototype.slice.call(points)]);
+  }, { coalesce: true });
+
+  // All ten moves arrive before the flush posted by the first one runs
+  var events = new qt.QTestEventList();
+  for (var i = 1; i <= 10; i++)
+    events.addMouseMove(i * 5, i * 3);
+  events.simulate(widget);
+  assert.equal(calls.length, 0);
+  app.processEvents();
+
+  assert.equal(calls.length, 1);
+  assert.equal(calls[0][0], 50);
+  assert.equal(calls[0][1], 30);
+  assert.equal(calls[0][2].length, 30);
+  for (var i = 0; i < 10; i++)
+    assert.deepEqual(calls[0][2].slice(i * 3, i * 3 + 2),
+                     [(i + 1) * 5, (i + 1) * 3]);
+
+  // A press flushes the pending moves before its own callback
+  var order = [];
+  calls = [];
+  widget.mousePressEvent(function(e) {
+    order.push('press');
+  });
+  events = new qt.QTestEventList();
+  events.addMouseMove(10, 10);
+  events.addMouseMove(20, 20);
+  events.addMouseClick(qt.MouseButton.LeftButton);
+  widget.mouseMoveEvent(function(x, y, points) {
+    order.push('moves');
+    calls.push(Array.prototype.slice.call(points));
+  }, { coalesce: true });
+  events.simulate(widget);
+  assert.deepEqual(order, ['moves', 'press']);
+  assert.equal(calls.length, 1);
+  assert.deepEqual([calls[0][0], calls[0][1], calls[0][3], calls[0][4]],
+                   [10, 10, 20, 20]);
+  app.processEvents();
+  assert.deepEqual(order, ['moves', 'press']);
+
+  assert.throws(function() { events.addMouseMove('x'); }, TypeError);
+
+  widget.close();
+}
+
+// paintEvent() - damaged rects
+{
+  var damage = [];
+  var widget = new qt.QWidget;
+  widget.resize(200, 200);
+
+  widget.paintEvent(function(rects) {
+    damage.push(rects);
+  });
+
+  widget.show();
+  app.processEvents();
+  assert.ok(damage.length > 0);
+  assert.ok(damage[0] instanceof Int32Array);
+  assert.equal(damage[0].length % 4, 0);
+
+  // Partial update: only the requested rect is damaged
+  damage = [];
+  widget.update(10, 20, 30, 40);
+  app.processEvents();
+  assert.equal(damage.length, 1);
+  assert.deepEqual(Array.prototype.slice.call(damage[0]), [10, 20, 30, 40]);
+
+  // Region update
+  damage = [];
+  widget.update(new Int32Array([0, 0, 10, 10, 100, 100, 10, 10]));
+  app.processEvents();
+  assert.equal(damage.length, 1);
+  assert.equal(damage[0].length, 8);
+
+  assert.throws(function() {
+    widget.update('everything');
+  }, TypeError);
+
+  widget.close();
+}
+
+// update() - inherited by QWidget subclasses
+{
+  var damage = [];
+  var label = new qt.QLabel('text');
+  label.resize(100, 50);
+  label.paintEvent(function(rects) {
+    damage.push(Array.prototype.slice.call(rects));
+  });
+  label.show();
+  app.processEvents();
+
+  damage = [];
+  label.update(5, 6, 7, 8);
+  app.processEvents();
+  assert.deepEqual(damage, [[5, 6, 7, 8]]);
+
+  damage = [];
+  label.update();
+  app.processEvents();
+  assert.deepEqual(damage, [[0, 0, 100, 50]]);
+
+  label.close();
+}
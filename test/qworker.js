@@ -0,0 +1,127 @@
+// Copyright (c) 2012, Artur Adib
+// All rights reserved.
+//
+// Author(s): Artur Adib <aadib@mozilla.com>
+//
+// You may use this file under the terms of the New BSD license as follows:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Artur Adib nor the
+//       names of contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL ARTUR ADIB BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF 
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+var assert = require('assert'),
+    path = require('path'),
+    qt = require('..'),
+    test = require('./test');
+
+var worker_threads;
+try {
+  worker_threads = require('worker_threads');
+} catch (e) {
+  console.log('  skipped: no worker_threads in node ' + process.version);
+  return;
+}
+
+// Offscreen rendering that only needs QImage and QPainter
+function render(seed) {
+  var image = new qt.QImage(64, 64, qt.QImage.Format.Format_ARGB32);
+  var painter = new qt.QPainter();
+  painter.begin(image);
+  for (var i = 0; i < 32; i++) {
+    painter.fillRect((i * 7 + seed) % 56, (i * 13 + seed) % 56, 8, 8, 
+        new qt.QColor((i * 40 + seed) % 256, (i * 3) % 256, seed % 256));
+  }
+  var path = qt.QPainterPath.fromSvg('M 4 4 L 60 12 L 32 60 Z');
+  painter.fillPath(path, new qt.QColor(seed % 256, 128, 64));
+  painter.end();
+  return Buffer.from(image.bits());
+}
+
+if (!worker_threads.isMainThread) {
+  var seed = worker_threads.workerData;
+  var result = { seed: seed, bits: render(seed) };
+
+  // Widgets and pixmaps stay on the QApplication's thread
+  assert.throws(function() { new qt.QPixmap(4, 4); }, 
+      /only available on the thread that created the QApplication/);
+  assert.throws(function() { new qt.QWidget(); }, Error);
+  assert.throws(function() { qt.QPixmapCache.stats(); }, 
+      /only available on the thread that created the QApplication/);
+
+  // Text needs threaded font rendering; without it drawText() throws 
+  // rather than touching the font engine from this thread
+  var image = new qt.QImage(64, 64, qt.QImage.Format.Format_ARGB32);
+  var painter = new qt.QPainter();
+  painter.begin(image);
+  try {
+    painter.drawText(4, 20, 'worker');
+  } catch (e) {
+    assert.ok(/text can only be drawn/.test(e.message), e.message);
+  }
+  painter.end();
+
+  // Each isolate has its own load queue
+  qt.QImage.load(path.join(__dirname, 'resources/qimage.png'))
+      .then(function(image) {
+    result.loaded = image.width();
+    worker_threads.parentPort.postMessage(result);
+  }).catch(test.fail);
+  return;
+}
+
+var app = new qt.QApplication();
+
+function runWorkers(seeds) {
+  return Promise.all(seeds.map(function(seed) {
+    return new Promise(function(resolve, reject) {
+      var worker = new worker_threads.Worker(__filename, { workerData: seed });
+      var message = null;
+      worker.on('message', function(m) { message = m; });
+      worker.on('error', reject);
+      worker.on('exit', function(code) {
+        if (code !== 0 || !message)
+          return reject(new Error('worker ' + seed + ' exited with ' + code));
+        resolve(message);
+      });
+    });
+  }));
+}
+
+function check(results) {
+  results.forEach(function(result) {
+    assert.ok(Buffer.from(result.bits).equals(render(result.seed)), 
+        'worker ' + result.seed + ' rendered differently');
+    assert.equal(result.loaded, 100);
+  });
+}
+
+// Concurrent workers render the same pixels as the main thread; a second
+// round loads the addon again after the first isolates were torn down
+runWorkers([1, 2, 3, 4]).then(function(results) {
+  check(results);
+  return runWorkers([5, 6]);
+}).then(function(results) {
+  check(results);
+
+  // The main isolate's templates survive the workers' cleanup
+  assert.ok(new qt.QPixmap(4, 4) instanceof qt.QPixmap);
+  assert.ok(new qt.QImage(4, 4, qt.QImage.Format.Format_ARGB32));
+}).catch(test.fail);
@@ -1,15 +1,36 @@
 var fs = require('fs'),
-    path = require('path');
+    path = require('path'),
+    qt = require('..');
 
 var testDir = __dirname+'/img-test/',
-    refDir = __dirname+'/img-ref/';
+    refDir = __dirname+'/img-ref/',
+    diffDir = __dirname+'/img-diff/';
 
 if (!fs.existsSync(testDir)) {
   console.log('! regression warning: img-test/ dir does not exist. creating it...')
   fs.mkdirSync(testDir);
 }
 
-exports.regression = function(name, pixmap, callback) {
+// Ends the run on an error from an asynchronous test, e.g. a rejected
+// promise: .catch(test.fail)
+exports.fail = function(err) {
+  console.error(err.stack);
+  process.exit(1);
+}
+
+// Forces a full garbage collection, with or without --expose-gc
+exports.gc = function() {
+  if (!global.gc) {
+    require('v8').setFlagsFromString('--expose_gc');
+    global.gc = require('vm').runInNewContext('gc');
+  }
+  global.gc();
+}
+
+// Compares decoded pixels, so PNG encoder differences don't matter. 
+// options are passed to qt.compareImages() (tolerance, maxDiffPixels); on a
+// regression the diff image is written to img-diff/.
+exports.regression = function(name, pixmap, callback, options) {
   callback();
       
   pixmap.save(testDir+name+'.png');
@@ -19,10 +40,28 @@ exports.regression = function(name, pixmap, callback) {
     console.log('! regression warning: could not find reference file for test:', name)
     return;
   }
-  
-  var testBuf = fs.readFileSync(testDir+name+'.png');
-  var refBuf = fs.readFileSync(refDir+name+'.png');
-  if (testBuf.toString() !== refBuf.toString()) {
-    console.log('!!! image regression in test:', name);
+
+  var ref = new qt.QImage(refDir+name+'.png');
+  var result = qt.compareImages(pixmap, ref, {
+    tolerance: options && options.tolerance,
+    maxDiffPixels: options && options.maxDiffPixels,
+    diffImage: true
+  });
+
+  if (!result.match) {
+    if (result.sizeMismatch) {
+      console.log('!!! image regression in test:', name, '(size differs)');
+      return;
+    }
+
+    console.log('!!! image regression in test:', name, '(' + 
+        result.diffPixels + ' pixels differ, max delta ' + result.maxDelta + 
+        ')');
+
+    if (!fs.existsSync(diffDir))
+      fs.mkdirSync(diffDir);
+    result.diffImage.saveAsync(diffDir+name+'.png').catch(function(err) {
+      console.log('! could not write diff image for test:', name, err.message);
+    });
   }
 }